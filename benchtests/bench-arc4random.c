@@ -52,7 +52,12 @@ timer_stop (void)
   support_delete_timer (timer);
 }
 
-static const uint32_t sizes[] = { 0, 16, 32, 48, 64, 80, 96, 112, 128 };
+static const uint32_t sizes[] = { 0, 16, 32, 48, 64, 80, 96, 112, 128,
+				  256, 1024, 4096, 65536 };
+
+/* Number of threads calling arc4random concurrently in the
+   multi-thread benchmark.  */
+static const unsigned int nthreads[] = { 2, 4, 16 };
 
 static double
 bench_throughput (void)
@@ -171,6 +176,59 @@ bench_singlethread (json_ctx_t *json_ctx)
   json_element_object_end (json_ctx);
 }
 
+struct thread_args
+{
+  size_t len;
+  double result;
+};
+
+static void *
+throughput_thread (void *closure)
+{
+  struct thread_args *args = closure;
+  args->result = args->len == 0
+    ? bench_throughput () : bench_buf_throughput (args->len);
+  return NULL;
+}
+
+/* Report the aggregated throughput of all the threads, which should
+   scale with the number of threads since the state is per-thread.  */
+static void
+bench_multithread (json_ctx_t *json_ctx)
+{
+  for (int t = 0; t < array_length (nthreads); t++)
+    {
+      json_element_object_begin (json_ctx);
+      json_attr_uint (json_ctx, "threads", nthreads[t]);
+
+      json_array_begin (json_ctx, "throughput");
+      for (int i = 0; i < array_length (sizes); i++)
+	{
+	  pthread_t threads[nthreads[t]];
+	  struct thread_args args[nthreads[t]];
+
+	  timer_start ();
+	  for (int j = 0; j < nthreads[t]; j++)
+	    {
+	      args[j].len = sizes[i];
+	      threads[j] = xpthread_create (NULL, throughput_thread, &args[j]);
+	    }
+	  double r = 0;
+	  for (int j = 0; j < nthreads[t]; j++)
+	    {
+	      xpthread_join (threads[j]);
+	      r += args[j].result;
+	    }
+	  timer_stop ();
+
+	  json_element_double (json_ctx, r);
+	}
+      json_array_end (json_ctx);
+
+      json_element_object_end (json_ctx);
+    }
+}
+
 static void
 run_bench (json_ctx_t *json_ctx, const char *name,
 	   char *const*fnames, size_t fnameslen,
@@ -206,6 +264,8 @@ do_test (void)
 
   run_bench (&json_ctx, "single-thread", fnames, array_length (fnames),
 	     bench_singlethread);
+  run_bench (&json_ctx, "multi-thread", fnames, array_length (fnames),
+	     bench_multithread);
 
   json_document_end (&json_ctx);
 
@@ -0,0 +1,115 @@
+/* Measure crypt_r throughput for the MD5, SHA256 and SHA512 methods.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <crypt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench-timing.h"
+#include "json-lib.h"
+
+/* Number of hashes computed for each method.  The SHA methods use
+   5000 rounds by default, the rounds=1000 salts use the minimum.  */
+#define NITERS 64
+
+static const struct
+{
+  const char *name;
+  const char *salt;
+} methods[] =
+  {
+    { "md5", "$1$saltstring" },
+    { "sha256", "$5$saltstring" },
+    { "sha256-rounds-1000", "$5$rounds=1000$saltstring" },
+    { "sha512", "$6$saltstring" },
+    { "sha512-rounds-1000", "$6$rounds=1000$saltstring" },
+  };
+
+static const char *const keys[] =
+  {
+    "a", "password", "correct horse battery staple",
+    "we have a short salt string but not a short password"
+  };
+
+static void
+do_bench (json_ctx_t *json_ctx, struct crypt_data *data,
+	  const char *name, const char *salt)
+{
+  timing_t total = 0;
+  struct timespec start_ts, end_ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &start_ts);
+  for (size_t i = 0; i < NITERS; i++)
+    {
+      timing_t start, end, elapsed;
+      const char *key = keys[i % array_length (keys)];
+
+      TIMING_NOW (start);
+      char *hash = crypt_r (key, salt, data);
+      TIMING_NOW (end);
+
+      if (hash == NULL || hash[0] != '$')
+	{
+	  printf ("crypt_r failed for %s\n", salt);
+	  exit (1);
+	}
+
+      TIMING_DIFF (elapsed, start, end);
+      TIMING_ACCUM (total, elapsed);
+    }
+  clock_gettime (CLOCK_MONOTONIC, &end_ts);
+
+  double secs = (end_ts.tv_sec - start_ts.tv_sec)
+		+ (end_ts.tv_nsec - start_ts.tv_nsec) / 1e9;
+
+  json_attr_object_begin (json_ctx, name);
+  json_attr_double (json_ctx, "mean", (double) total / NITERS);
+  json_attr_double (json_ctx, "hashes-per-second", NITERS / secs);
+  json_attr_object_end (json_ctx);
+}
+
+int
+main (int argc, char **argv)
+{
+  struct crypt_data *data = calloc (1, sizeof (*data));
+  if (data == NULL)
+    {
+      perror ("calloc");
+      return 1;
+    }
+
+  json_ctx_t json_ctx;
+  json_init (&json_ctx, 0, stdout);
+  json_document_begin (&json_ctx);
+
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, "crypt_r");
+
+  for (size_t i = 0; i < array_length (methods); i++)
+    do_bench (&json_ctx, data, methods[i].name, methods[i].salt);
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+
+  free (data);
+  return 0;
+}
@@ -0,0 +1,195 @@
+/* Measure dl_iterate_phdr throughput with concurrent dlopen.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Each worker thread repeatedly looks up the object containing a
+   program counter with dl_iterate_phdr, the way an unwinder without
+   _dl_find_object support locates the unwind tables for every frame
+   of a thrown exception.  Optionally, another thread dlopens and
+   dlcloses a shared object in a loop, which modifies the list of
+   loaded objects while the lookups run.  */
+
+#include "json-lib.h"
+#include <array_length.h>
+#include <dlfcn.h>
+#include <gnu/lib-names.h>
+#include <link.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/timespec.h>
+#include <support/xdlfcn.h>
+#include <support/xthread.h>
+
+static volatile sig_atomic_t timer_finished;
+
+static void
+timer_callback (int unused)
+{
+  timer_finished = 1;
+}
+
+static const unsigned int nthreads[] = { 1, 4, 16, 64 };
+
+/* Lookup request for phdr_callback.  */
+struct lookup
+{
+  uintptr_t pc;
+  bool found;
+};
+
+/* Find the PT_LOAD segment containing PC, like
+   _Unwind_IteratePhdrCallback in libgcc.  */
+static int
+phdr_callback (struct dl_phdr_info *info, size_t size, void *closure)
+{
+  struct lookup *lookup = closure;
+  for (int i = 0; i < info->dlpi_phnum; ++i)
+    {
+      const ElfW(Phdr) *ph = &info->dlpi_phdr[i];
+      if (ph->p_type != PT_LOAD)
+	continue;
+      uintptr_t start = info->dlpi_addr + ph->p_vaddr;
+      if (lookup->pc >= start && lookup->pc < start + ph->p_memsz)
+	{
+	  lookup->found = true;
+	  return 1;
+	}
+    }
+  return 0;
+}
+
+/* Program counters looked up by the worker threads: one in the main
+   program and one in libc, to cover different positions in the list
+   of loaded objects.  */
+static uintptr_t pcs[2];
+
+static void *
+worker (void *closure)
+{
+  uint64_t *count = closure;
+  uint64_t n = 0;
+  while (!timer_finished)
+    {
+      struct lookup lookup = { .pc = pcs[n % array_length (pcs)] };
+      dl_iterate_phdr (phdr_callback, &lookup);
+      if (!lookup.found)
+	FAIL_EXIT1 ("address %p not found", (void *) lookup.pc);
+      ++n;
+    }
+  *count = n;
+  return NULL;
+}
+
+static void *
+loader (void *closure)
+{
+  uint64_t *count = closure;
+  uint64_t n = 0;
+  while (!timer_finished)
+    {
+      void *handle = xdlopen (LIBM_SO, RTLD_NOW);
+      xdlclose (handle);
+      ++n;
+    }
+  *count = n;
+  return NULL;
+}
+
+/* Run NTHREADS lookup threads for DURATION seconds, with a concurrent
+   dlopen/dlclose loop if WITH_LOADER.  Returns the number of lookups
+   per second, summed over all threads.  */
+static double
+bench_lookups (unsigned int nthreads, bool with_loader)
+{
+  pthread_t threads[nthreads];
+  uint64_t counts[nthreads];
+  pthread_t loader_thread;
+  uint64_t loads = 0;
+
+  timer_finished = 0;
+  timer_t timer = support_create_timer (DURATION, 0, false, timer_callback);
+
+  struct timespec start, end;
+  clock_gettime (CLOCK_MONOTONIC, &start);
+  for (unsigned int i = 0; i < nthreads; ++i)
+    threads[i] = xpthread_create (NULL, worker, &counts[i]);
+  if (with_loader)
+    loader_thread = xpthread_create (NULL, loader, &loads);
+
+  uint64_t total = 0;
+  for (unsigned int i = 0; i < nthreads; ++i)
+    {
+      xpthread_join (threads[i]);
+      total += counts[i];
+    }
+  if (with_loader)
+    xpthread_join (loader_thread);
+  clock_gettime (CLOCK_MONOTONIC, &end);
+  support_delete_timer (timer);
+
+  struct timespec diff = timespec_sub (end, start);
+  double duration = (double) diff.tv_sec
+    + (double) diff.tv_nsec / TIMESPEC_HZ;
+  return (double) total / duration;
+}
+
+static void
+run_bench (json_ctx_t *json_ctx, const char *name, bool with_loader)
+{
+  json_attr_object_begin (json_ctx, name);
+  json_array_begin (json_ctx, "threads");
+  for (int i = 0; i < array_length (nthreads); i++)
+    json_element_uint (json_ctx, nthreads[i]);
+  json_array_end (json_ctx);
+
+  json_array_begin (json_ctx, "lookups-per-second");
+  for (int i = 0; i < array_length (nthreads); i++)
+    json_element_double (json_ctx, bench_lookups (nthreads[i], with_loader));
+  json_array_end (json_ctx);
+  json_attr_object_end (json_ctx);
+}
+
+static int
+do_test (void)
+{
+  pcs[0] = (uintptr_t) &do_test;
+  pcs[1] = (uintptr_t) &dl_iterate_phdr;
+
+  json_ctx_t json_ctx;
+  json_init (&json_ctx, 0, stdout);
+
+  json_document_begin (&json_ctx);
+  json_attr_string (&json_ctx, "timing_type", "clock_gettime");
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, "dl_iterate_phdr");
+
+  run_bench (&json_ctx, "lookup", false);
+  run_bench (&json_ctx, "lookup-concurrent-dlopen", true);
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
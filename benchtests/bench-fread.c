@@ -0,0 +1,153 @@
+/* Measure the throughput of sequential reads from a stream.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bench-timing.h"
+#include "json-lib.h"
+
+/* Size of the file which is read.  It is read through once before the
+   measurements so that it is in the page cache, and the time is spent
+   in the library and in the system calls.  */
+#define FILE_SIZE (64 * 1024 * 1024)
+
+/* Number of passes over the file for each read size.  */
+#define NPASSES 4
+
+/* Size of the fread calls, 0 for getc.  Reads smaller than the stream
+   buffer are copied out of the buffer, which grows while the file is
+   read sequentially.  */
+static const size_t read_sizes[] = { 0, 16, 100, 1024, 4000 };
+
+static char filename[] = "/tmp/bench-fread.XXXXXX";
+
+static void
+create_file (void)
+{
+  int fd = mkstemp (filename);
+  if (fd < 0)
+    {
+      perror ("mkstemp");
+      exit (1);
+    }
+  char *buf = malloc (65536);
+  if (buf == NULL)
+    {
+      perror ("malloc");
+      exit (1);
+    }
+  memset (buf, 'x', 65536);
+  for (size_t i = 0; i < FILE_SIZE / 65536; i++)
+    if (write (fd, buf, 65536) != 65536)
+      {
+	perror ("write");
+	exit (1);
+      }
+  close (fd);
+  free (buf);
+}
+
+static size_t
+read_file (size_t size, char *buf)
+{
+  FILE *fp = fopen (filename, "r");
+  if (fp == NULL)
+    {
+      perror (filename);
+      exit (1);
+    }
+  size_t total = 0;
+  if (size == 0)
+    while (getc (fp) != EOF)
+      total++;
+  else
+    {
+      size_t n;
+      while ((n = fread (buf, 1, size, fp)) > 0)
+	total += n;
+    }
+  fclose (fp);
+  if (total != FILE_SIZE)
+    {
+      printf ("short read of %s: %zu\n", filename, total);
+      exit (1);
+    }
+  return total;
+}
+
+int
+main (int argc, char **argv)
+{
+  create_file ();
+  char *buf = malloc (read_sizes[array_length (read_sizes) - 1]);
+  if (buf == NULL)
+    {
+      perror ("malloc");
+      return 1;
+    }
+  read_file (4000, buf);
+
+  json_ctx_t json_ctx;
+  json_init (&json_ctx, 0, stdout);
+  json_document_begin (&json_ctx);
+
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, "fread");
+
+  for (size_t r = 0; r < array_length (read_sizes); r++)
+    {
+      size_t size = read_sizes[r];
+      struct timespec start_ts, end_ts;
+      timing_t start, end, elapsed;
+      clock_gettime (CLOCK_MONOTONIC, &start_ts);
+      TIMING_NOW (start);
+      for (int i = 0; i < NPASSES; i++)
+	read_file (size, buf);
+      TIMING_NOW (end);
+      clock_gettime (CLOCK_MONOTONIC, &end_ts);
+      TIMING_DIFF (elapsed, start, end);
+
+      double secs = (end_ts.tv_sec - start_ts.tv_sec)
+		    + (end_ts.tv_nsec - start_ts.tv_nsec) / 1e9;
+
+      char name[32];
+      if (size == 0)
+	strcpy (name, "getc");
+      else
+	snprintf (name, sizeof (name), "%zu", size);
+      json_attr_object_begin (&json_ctx, name);
+      json_attr_double (&json_ctx, "mean", (double) elapsed / NPASSES);
+      json_attr_double (&json_ctx, "mb-per-second",
+			(double) NPASSES * FILE_SIZE / secs / 1e6);
+      json_attr_object_end (&json_ctx);
+    }
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+
+  unlink (filename);
+  free (buf);
+  return 0;
+}
@@ -0,0 +1,123 @@
+/* Measure fwrite throughput for different record sizes.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench-timing.h"
+#include "json-lib.h"
+
+/* Total number of bytes written for each record size.  */
+#define TOTAL_SIZE (64 * 1024 * 1024)
+
+/* The records are written to /dev/null, so that the time is spent in
+   the library and in the system calls rather than in the file system.
+   Records larger than the stream buffer cause a flush of the buffered
+   data followed by a direct write of the record.  */
+static const size_t record_sizes[] =
+  {
+    16, 100, 1024, 4000, 5000, 16 * 1024 + 100, 64 * 1024 + 100
+  };
+
+static const size_t buffer_sizes[] = { 4096, 65536 };
+
+static void
+do_bench (json_ctx_t *json_ctx, const char *buffering, int mode,
+	  size_t bufsize)
+{
+  char name[32];
+  snprintf (name, sizeof (name), "%s-%zu", buffering, bufsize);
+  json_attr_object_begin (json_ctx, name);
+
+  for (size_t r = 0; r < array_length (record_sizes); r++)
+    {
+      size_t size = record_sizes[r];
+      size_t iters = TOTAL_SIZE / size;
+      char *record = malloc (size);
+      if (record == NULL)
+	{
+	  perror ("malloc");
+	  exit (1);
+	}
+      /* A single newline at the end, like a log record.  */
+      memset (record, 'x', size - 1);
+      record[size - 1] = '\n';
+
+      FILE *fp = fopen ("/dev/null", "w");
+      if (fp == NULL || setvbuf (fp, NULL, mode, bufsize) != 0)
+	{
+	  perror ("/dev/null");
+	  exit (1);
+	}
+
+      struct timespec start_ts, end_ts;
+      timing_t start, end, elapsed;
+      clock_gettime (CLOCK_MONOTONIC, &start_ts);
+      TIMING_NOW (start);
+      for (size_t i = 0; i < iters; i++)
+	if (fwrite (record, 1, size, fp) != size)
+	  {
+	    perror ("fwrite");
+	    exit (1);
+	  }
+      fflush (fp);
+      TIMING_NOW (end);
+      clock_gettime (CLOCK_MONOTONIC, &end_ts);
+      TIMING_DIFF (elapsed, start, end);
+      fclose (fp);
+      free (record);
+
+      double secs = (end_ts.tv_sec - start_ts.tv_sec)
+		    + (end_ts.tv_nsec - start_ts.tv_nsec) / 1e9;
+
+      snprintf (name, sizeof (name), "%zu", size);
+      json_attr_object_begin (json_ctx, name);
+      json_attr_double (json_ctx, "mean", (double) elapsed / iters);
+      json_attr_double (json_ctx, "mb-per-second",
+			(double) iters * size / secs / 1e6);
+      json_attr_object_end (json_ctx);
+    }
+
+  json_attr_object_end (json_ctx);
+}
+
+int
+main (int argc, char **argv)
+{
+  json_ctx_t json_ctx;
+  json_init (&json_ctx, 0, stdout);
+  json_document_begin (&json_ctx);
+
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, "fwrite");
+
+  for (size_t b = 0; b < array_length (buffer_sizes); b++)
+    {
+      do_bench (&json_ctx, "full", _IOFBF, buffer_sizes[b]);
+      do_bench (&json_ctx, "line", _IOLBF, buffer_sizes[b]);
+    }
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+  return 0;
+}
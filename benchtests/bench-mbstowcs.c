@@ -0,0 +1,133 @@
+/* Measure mbstowcs and wcstombs in a UTF-8 locale.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "bench-timing.h"
+#include "json-lib.h"
+
+#define NITERS 100
+#define LEN 65536
+
+/* Percentage of non-ASCII characters in the input.  */
+static const int densities[] = { 0, 1, 10, 50, 100 };
+
+/* Non-ASCII characters of 2, 3 and 4 bytes in UTF-8.  */
+static const wchar_t non_ascii[] = L"éж€中😀";
+
+static wchar_t wcs[LEN + 1];
+static wchar_t wcs_out[LEN + 1];
+static char mbs[4 * LEN + 1];
+static char mbs_out[4 * LEN + 1];
+
+static void
+fill (int density)
+{
+  for (size_t i = 0; i < LEN; i++)
+    if (random () % 100 < density)
+      wcs[i] = non_ascii[random () % (array_length (non_ascii) - 1)];
+    else
+      wcs[i] = L' ' + random () % 95;
+  wcs[LEN] = L'\0';
+
+  if (wcstombs (mbs, wcs, sizeof (mbs)) == (size_t) -1)
+    {
+      perror ("wcstombs");
+      exit (1);
+    }
+}
+
+static void
+do_bench (json_ctx_t *json_ctx, const char *name, int is_mbstowcs)
+{
+  json_attr_object_begin (json_ctx, name);
+
+  for (size_t i = 0; i < array_length (densities); i++)
+    {
+      char density[8];
+      snprintf (density, sizeof (density), "%d%%", densities[i]);
+
+      srandom (1);
+      fill (densities[i]);
+
+      timing_t min = 0x7fffffffffffffff, max = 0, total = 0;
+      for (size_t n = 0; n < NITERS; n++)
+	{
+	  timing_t start, end, elapsed;
+	  size_t ret;
+
+	  TIMING_NOW (start);
+	  if (is_mbstowcs)
+	    ret = mbstowcs (wcs_out, mbs, array_length (wcs_out));
+	  else
+	    ret = wcstombs (mbs_out, wcs, sizeof (mbs_out));
+	  TIMING_NOW (end);
+
+	  if (ret == (size_t) -1)
+	    {
+	      perror (name);
+	      exit (1);
+	    }
+
+	  TIMING_DIFF (elapsed, start, end);
+	  if (min > elapsed)
+	    min = elapsed;
+	  if (max < elapsed)
+	    max = elapsed;
+	  TIMING_ACCUM (total, elapsed);
+	}
+
+      json_attr_object_begin (json_ctx, density);
+      json_attr_uint (json_ctx, "length", LEN);
+      json_attr_double (json_ctx, "max", max);
+      json_attr_double (json_ctx, "min", min);
+      json_attr_double (json_ctx, "mean", total / NITERS);
+      json_attr_object_end (json_ctx);
+    }
+
+  json_attr_object_end (json_ctx);
+}
+
+int
+main (int argc, char **argv)
+{
+  if (setlocale (LC_ALL, "en_US.UTF-8") == NULL)
+    {
+      perror ("setlocale");
+      return 1;
+    }
+
+  json_ctx_t json_ctx;
+  json_init (&json_ctx, 0, stdout);
+  json_document_begin (&json_ctx);
+
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+  json_attr_object_begin (&json_ctx, "functions");
+
+  do_bench (&json_ctx, "mbstowcs", 1);
+  do_bench (&json_ctx, "wcstombs", 0);
+
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+  return 0;
+}
@@ -198,6 +198,22 @@ do_random_tests (json_ctx_t *json_ctx)
     }
 }
 
+/* Search for needles of 8 to 512 bytes placed at the end of the
+   haystack, so the whole haystack is scanned.  The needle bytes are
+   outside of the range of the haystack bytes.  */
+static void
+do_long_needle_tests (json_ctx_t *json_ctx)
+{
+  char needle[512];
+
+  for (size_t len = 8; len <= sizeof (needle); len *= 2)
+    {
+      for (size_t i = 0; i < len; ++i)
+	needle[i] = 'a' + random () % 26;
+      do_test (json_ctx, needle, len, BUF1PAGES * page_size - len);
+    }
+}
+
 static const char *const strs[] =
   {
     "00000", "00112233", "0123456789", "0000111100001111",
@@ -240,6 +256,7 @@ test_main (void)
       }
 
   do_random_tests (&json_ctx);
+  do_long_needle_tests (&json_ctx);
 
   json_array_end (&json_ctx);
   json_attr_object_end (&json_ctx);
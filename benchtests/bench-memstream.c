@@ -0,0 +1,162 @@
+/* Measure fprintf into open_memstream buffers of different final sizes.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench-timing.h"
+#include "json-lib.h"
+
+/* Total number of bytes formatted for each message size.  */
+#define TOTAL_SIZE (256 * 1024 * 1024)
+
+/* Sizes of the messages, from small records to serialized messages
+   of several megabytes.  The buffers of the larger ones are allocated
+   with mmap by malloc.  */
+static const size_t message_sizes[] =
+  {
+    256, 4 * 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024
+  };
+
+/* Format a message of about SIZE bytes into FP.  */
+static void
+write_message (FILE *fp, size_t size)
+{
+  for (size_t written = 0; written < size; )
+    {
+      int ret = fprintf (fp, "key%zu=%d,%s;\n", written, (int) written,
+			 "value");
+      if (ret < 0)
+	{
+	  perror ("fprintf");
+	  exit (1);
+	}
+      written += ret;
+    }
+}
+
+/* Build each message in a new stream and take the buffer on
+   fclose.  */
+static size_t
+messages_fclose (size_t size, size_t count)
+{
+  size_t total = 0;
+  for (size_t i = 0; i < count; i++)
+    {
+      char *buf;
+      size_t len;
+      FILE *fp = open_memstream (&buf, &len);
+      if (fp == NULL)
+	{
+	  perror ("open_memstream");
+	  exit (1);
+	}
+      write_message (fp, size);
+      fclose (fp);
+      total += len;
+      free (buf);
+    }
+  return total;
+}
+
+/* Build all messages in the same stream and take the buffer of each
+   with memstream_detach.  */
+static size_t
+messages_detach (size_t size, size_t count)
+{
+  size_t total = 0;
+  char *buf;
+  size_t len;
+  FILE *fp = open_memstream (&buf, &len);
+  if (fp == NULL)
+    {
+      perror ("open_memstream");
+      exit (1);
+    }
+  for (size_t i = 0; i < count; i++)
+    {
+      write_message (fp, size);
+      char *message = memstream_detach (fp, &len);
+      if (message == NULL)
+	{
+	  perror ("memstream_detach");
+	  exit (1);
+	}
+      total += len;
+      free (message);
+    }
+  fclose (fp);
+  free (buf);
+  return total;
+}
+
+static void
+do_bench (json_ctx_t *json_ctx, const char *name,
+	  size_t (*function) (size_t, size_t))
+{
+  json_attr_object_begin (json_ctx, name);
+
+  for (size_t m = 0; m < array_length (message_sizes); m++)
+    {
+      size_t size = message_sizes[m];
+      size_t count = TOTAL_SIZE / size;
+
+      struct timespec start_ts, end_ts;
+      timing_t start, end, elapsed;
+      clock_gettime (CLOCK_MONOTONIC, &start_ts);
+      TIMING_NOW (start);
+      size_t total = function (size, count);
+      TIMING_NOW (end);
+      clock_gettime (CLOCK_MONOTONIC, &end_ts);
+      TIMING_DIFF (elapsed, start, end);
+
+      double secs = (end_ts.tv_sec - start_ts.tv_sec)
+		    + (end_ts.tv_nsec - start_ts.tv_nsec) / 1e9;
+
+      char size_name[32];
+      snprintf (size_name, sizeof (size_name), "%zu", size);
+      json_attr_object_begin (json_ctx, size_name);
+      json_attr_double (json_ctx, "mean", (double) elapsed / count);
+      json_attr_double (json_ctx, "mb-per-second", total / secs / 1e6);
+      json_attr_object_end (json_ctx);
+    }
+
+  json_attr_object_end (json_ctx);
+}
+
+int
+main (int argc, char **argv)
+{
+  json_ctx_t json_ctx;
+  json_init (&json_ctx, 0, stdout);
+  json_document_begin (&json_ctx);
+
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, "memstream");
+
+  do_bench (&json_ctx, "fclose", messages_fclose);
+  do_bench (&json_ctx, "detach", messages_detach);
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+  return 0;
+}
@@ -0,0 +1,160 @@
+/* Measure qsort with different element sizes and input patterns.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench-timing.h"
+#include "json-lib.h"
+
+#define NITERS 10
+
+typedef enum
+  {
+    Sorted,
+    Reversed,
+    Random,
+    Duplicates,
+  } arraytype_t;
+
+static const char *const arraytype_names[] =
+  {
+    "sorted", "reversed", "random", "duplicates"
+  };
+
+static const size_t element_sizes[] = { 4, 8, 16, 32 };
+static const size_t element_counts[] = { 16, 1024, 65536 };
+
+/* Elements are compared by their first 32-bit word.  */
+static int
+compare (const void *a, const void *b)
+{
+  uint32_t ka, kb;
+  memcpy (&ka, a, sizeof (ka));
+  memcpy (&kb, b, sizeof (kb));
+  return (ka > kb) - (ka < kb);
+}
+
+static void
+fill_array (unsigned char *array, size_t nmemb, size_t size,
+	    arraytype_t type)
+{
+  memset (array, 0, nmemb * size);
+  for (size_t i = 0; i < nmemb; i++)
+    {
+      uint32_t key;
+      switch (type)
+	{
+	case Sorted:
+	  key = i;
+	  break;
+	case Reversed:
+	  key = nmemb - i;
+	  break;
+	case Random:
+	  key = random ();
+	  break;
+	case Duplicates:
+	  /* Only 16 distinct values.  */
+	  key = random () % 16;
+	  break;
+	default:
+	  abort ();
+	}
+      memcpy (array + i * size, &key, sizeof (key));
+    }
+}
+
+static void
+do_bench (json_ctx_t *json_ctx, arraytype_t type)
+{
+  json_attr_object_begin (json_ctx, arraytype_names[type]);
+
+  for (size_t s = 0; s < array_length (element_sizes); s++)
+    for (size_t n = 0; n < array_length (element_counts); n++)
+      {
+	size_t size = element_sizes[s];
+	size_t nmemb = element_counts[n];
+	unsigned char *input = malloc (nmemb * size);
+	unsigned char *array = malloc (nmemb * size);
+	if (input == NULL || array == NULL)
+	  {
+	    perror ("malloc");
+	    exit (1);
+	  }
+
+	srandom (1);
+	fill_array (input, nmemb, size, type);
+
+	/* Use fewer iterations for the large arrays.  */
+	size_t iters = NITERS * (element_counts[array_length (element_counts)
+						- 1] / nmemb);
+	if (iters > 100000)
+	  iters = 100000;
+
+	timing_t total = 0;
+	for (size_t i = 0; i < iters; i++)
+	  {
+	    timing_t start, end, elapsed;
+
+	    memcpy (array, input, nmemb * size);
+	    TIMING_NOW (start);
+	    qsort (array, nmemb, size, compare);
+	    TIMING_NOW (end);
+
+	    TIMING_DIFF (elapsed, start, end);
+	    TIMING_ACCUM (total, elapsed);
+	  }
+
+	char name[32];
+	snprintf (name, sizeof (name), "%zu x %zu", nmemb, size);
+	json_attr_object_begin (json_ctx, name);
+	json_attr_uint (json_ctx, "nmemb", nmemb);
+	json_attr_uint (json_ctx, "size", size);
+	json_attr_double (json_ctx, "mean", (double) total / iters);
+	json_attr_object_end (json_ctx);
+
+	free (input);
+	free (array);
+      }
+
+  json_attr_object_end (json_ctx);
+}
+
+int
+main (int argc, char **argv)
+{
+  json_ctx_t json_ctx;
+  json_init (&json_ctx, 0, stdout);
+  json_document_begin (&json_ctx);
+
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, "qsort");
+
+  for (arraytype_t type = Sorted; type <= Duplicates; type++)
+    do_bench (&json_ctx, type);
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+  return 0;
+}
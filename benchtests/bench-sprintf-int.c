@@ -0,0 +1,146 @@
+/* Measure sprintf throughput for integer conversions.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench-timing.h"
+#include "json-lib.h"
+
+#define NITERS (1024 * 1024)
+
+/* Values of different magnitudes, so that the number of digits
+   varies from call to call.  */
+static const long int values[] =
+  {
+    0, 7, 42, 999, 1001, 65535, 123456, 2147483647, -1, -12345,
+    -2147483647, 1000000007, 31337, 8, 100, 4096
+  };
+
+static char buf[256];
+
+/* Each function converts the values in a different way.  The format
+   strings are not literals at the call sites, so that the compiler
+   cannot turn the calls into something else.  */
+
+static int
+do_int (const char *format, long int value)
+{
+  return sprintf (buf, format, (int) value);
+}
+
+static int
+do_unsigned (const char *format, long int value)
+{
+  return sprintf (buf, format, (unsigned int) value);
+}
+
+static int
+do_long (const char *format, long int value)
+{
+  return sprintf (buf, format, value * 1000003);
+}
+
+static int
+do_unsigned_long (const char *format, long int value)
+{
+  return sprintf (buf, format, (unsigned long int) value * 1000003);
+}
+
+static int
+do_size (const char *format, long int value)
+{
+  return sprintf (buf, format, (size_t) value);
+}
+
+static int
+do_four_ints (const char *format, long int value)
+{
+  return sprintf (buf, format, (int) value, (int) value / 3,
+		  (int) value * 7, (int) value % 10);
+}
+
+static const struct
+{
+  const char *name;
+  const char *format;
+  int (*function) (const char *, long int);
+} conversions[] =
+  {
+    { "d", "%d", do_int },
+    { "u", "%u", do_unsigned },
+    { "x", "%x", do_unsigned },
+    { "ld", "%ld", do_long },
+    { "lu", "%lu", do_unsigned_long },
+    { "zu", "%zu", do_size },
+    { "d-d-d-d", "%d %d %d %d\n", do_four_ints },
+    /* The general path, for comparison.  */
+    { "5d", "%5d", do_int },
+    { "-8ld", "%-8ld", do_long },
+  };
+
+static void
+do_bench (json_ctx_t *json_ctx, const char *name, const char *format,
+	  int (*function) (const char *, long int))
+{
+  struct timespec start_ts, end_ts;
+  timing_t start, end, elapsed;
+
+  clock_gettime (CLOCK_MONOTONIC, &start_ts);
+  TIMING_NOW (start);
+  for (size_t i = 0; i < NITERS; i++)
+    if (function (format, values[i % array_length (values)]) < 0)
+      {
+	perror ("sprintf");
+	exit (1);
+      }
+  TIMING_NOW (end);
+  clock_gettime (CLOCK_MONOTONIC, &end_ts);
+  TIMING_DIFF (elapsed, start, end);
+
+  double secs = (end_ts.tv_sec - start_ts.tv_sec)
+		+ (end_ts.tv_nsec - start_ts.tv_nsec) / 1e9;
+
+  json_attr_object_begin (json_ctx, name);
+  json_attr_double (json_ctx, "mean", (double) elapsed / NITERS);
+  json_attr_double (json_ctx, "calls-per-second", NITERS / secs);
+  json_attr_object_end (json_ctx);
+}
+
+int
+main (int argc, char **argv)
+{
+  json_ctx_t json_ctx;
+  json_init (&json_ctx, 0, stdout);
+  json_document_begin (&json_ctx);
+
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, "sprintf-int");
+
+  for (size_t i = 0; i < array_length (conversions); i++)
+    do_bench (&json_ctx, conversions[i].name, conversions[i].format,
+	      conversions[i].function);
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+  return 0;
+}
@@ -0,0 +1,141 @@
+/* Measure sscanf throughput for common conversions.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench-timing.h"
+#include "json-lib.h"
+
+#define NITERS (1024 * 1024)
+
+static int i1, i2, i3, i4;
+static unsigned int u1;
+static long int l1;
+static char s1[64], s2[64];
+
+/* Each function scans its input in a different way.  The format
+   strings are not literals at the call sites, so that the compiler
+   cannot turn the calls into something else.  */
+
+static int
+do_int (const char *input, const char *format)
+{
+  return sscanf (input, format, &i1) != 1;
+}
+
+static int
+do_unsigned (const char *input, const char *format)
+{
+  return sscanf (input, format, &u1) != 1;
+}
+
+static int
+do_long (const char *input, const char *format)
+{
+  return sscanf (input, format, &l1) != 1;
+}
+
+static int
+do_four_ints (const char *input, const char *format)
+{
+  return sscanf (input, format, &i1, &i2, &i3, &i4) != 4;
+}
+
+static int
+do_string (const char *input, const char *format)
+{
+  return sscanf (input, format, s1) != 1;
+}
+
+static int
+do_key_value (const char *input, const char *format)
+{
+  return sscanf (input, format, s1, s2, &i1) != 2;
+}
+
+static const struct
+{
+  const char *name;
+  const char *input;
+  const char *format;
+  int (*function) (const char *, const char *);
+} conversions[] =
+  {
+    { "d", "-123456", "%d", do_int },
+    { "u", "4000000000", "%u", do_unsigned },
+    { "x", "0xdeadbeef", "%x", do_unsigned },
+    { "ld", "1234567890123", "%ld", do_long },
+    { "d-d-d-d", "192.168.100.1", "%d.%d.%d.%d", do_four_ints },
+    { "s", "  identifier_name rest", "%s", do_string },
+    { "key-value", "name=some value;", "%[^=]=%[^;];%n", do_key_value },
+    /* The general path, for comparison.  */
+    { "5d", "-123456", "%5d", do_int },
+    { "i", "0x1f", "%i", do_int },
+  };
+
+static void
+do_bench (json_ctx_t *json_ctx, const char *name, const char *input,
+	  const char *format, int (*function) (const char *, const char *))
+{
+  struct timespec start_ts, end_ts;
+  timing_t start, end, elapsed;
+
+  clock_gettime (CLOCK_MONOTONIC, &start_ts);
+  TIMING_NOW (start);
+  for (size_t i = 0; i < NITERS; i++)
+    if (function (input, format))
+      {
+	fprintf (stderr, "sscanf (\"%s\", \"%s\") failed\n", input, format);
+	exit (1);
+      }
+  TIMING_NOW (end);
+  clock_gettime (CLOCK_MONOTONIC, &end_ts);
+  TIMING_DIFF (elapsed, start, end);
+
+  double secs = (end_ts.tv_sec - start_ts.tv_sec)
+		+ (end_ts.tv_nsec - start_ts.tv_nsec) / 1e9;
+
+  json_attr_object_begin (json_ctx, name);
+  json_attr_double (json_ctx, "mean", (double) elapsed / NITERS);
+  json_attr_double (json_ctx, "calls-per-second", NITERS / secs);
+  json_attr_object_end (json_ctx);
+}
+
+int
+main (int argc, char **argv)
+{
+  json_ctx_t json_ctx;
+  json_init (&json_ctx, 0, stdout);
+  json_document_begin (&json_ctx);
+
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, "sscanf");
+
+  for (size_t i = 0; i < array_length (conversions); i++)
+    do_bench (&json_ctx, conversions[i].name, conversions[i].input,
+	      conversions[i].format, conversions[i].function);
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+  return 0;
+}
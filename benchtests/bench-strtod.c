@@ -85,6 +85,52 @@ static const char *inputs[] =
   NULL
 };
 
+/* Numbers as they typically appear in JSON documents: coordinates,
+   prices, timestamps and physical constants.  */
+static const char *json_inputs[] =
+{
+  "-122.4194155", "37.7749295", "51.5073509", "-0.1277583", "19.99",
+  "1299.00", "0.5", "1684150000.123", "1.0", "-73.98513", "40.758896",
+  "6.02214076e23", "1.602176634e-19", "299792458", "3.141592653589793",
+  "2.718281828459045", "0.1", "0.30000000000000004", "1e-7",
+  "123456789012345678", "9007199254740993", "-0.0", "42", "100",
+  NULL
+};
+
+/* Numbers as they typically appear in CSV files of measurements.  */
+static const char *csv_inputs[] =
+{
+  "23.5", "0.0012", "1013.25", "-40.125", "99.999", "7.3", "65.02",
+  "0.000345", "12.0", "1.5E3", "-3.75", "250.125", "18.66", "0.98",
+  "1024", "4.4e-5", "87.5", "-0.25", "3.3", "1200.75",
+  NULL
+};
+
+/* Time strtod over all the numbers in INPUTS, and print the mean time
+   per number.  */
+static void
+do_bench_corpus (const char *name, const char **inputs)
+{
+  const size_t iters = INNER_LOOP_ITERS / 16;
+  size_t n = 0;
+  timing_t start, stop, cur;
+  char *ep;
+
+  while (inputs[n] != NULL)
+    ++n;
+
+  printf ("Corpus %-23s:", name);
+  TIMING_NOW (start);
+  for (size_t j = 0; j < iters; ++j)
+    for (size_t i = 0; i < n; ++i)
+      strtod (inputs[i], &ep);
+  TIMING_NOW (stop);
+
+  TIMING_DIFF (cur, start, stop);
+  TIMING_PRINT_MEAN ((double) cur, (double) (iters * n));
+  putchar ('\n');
+}
+
 int
 do_bench (void)
 {
@@ -106,6 +152,9 @@ do_bench (void)
       putchar ('\n');
     }
 
+  do_bench_corpus ("json", json_inputs);
+  do_bench_corpus ("csv", csv_inputs);
+
   return 0;
 }
 
@@ -0,0 +1,101 @@
+/* Measure TLS access in dlopen'ed modules.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The accessor functions in the modules use the general dynamic TLS
+   model.  Access is measured right after loading the first module,
+   after loading a second, unrelated module with TLS (which advances
+   the global TLS generation counter past the one recorded in the
+   DTV of the current thread), and in a thread created after both
+   modules have been loaded.  */
+
+#include "bench-timing.h"
+#include "bench-util.h"
+#include "json-lib.h"
+#include <dlfcn.h>
+#include <stdio.h>
+#include <support/xdlfcn.h>
+#include <support/xthread.h>
+
+typedef unsigned int (*accessor_t) (void);
+
+static accessor_t access_mod1;
+
+/* Returns the average number of timing units per TLS access.  */
+static double
+bench_accessor (accessor_t accessor)
+{
+  const size_t iters = 1 << 20;
+  timing_t start, stop, cur;
+
+  /* Warm up, and allocate the TLS block of the module.  */
+  for (size_t i = 0; i < 1024; i++)
+    DO_NOT_OPTIMIZE_OUT (accessor ());
+
+  TIMING_NOW (start);
+  for (size_t i = 0; i < iters; i++)
+    DO_NOT_OPTIMIZE_OUT (accessor ());
+  TIMING_NOW (stop);
+
+  TIMING_DIFF (cur, start, stop);
+  return (double) cur / (double) iters;
+}
+
+static void *
+thread_func (void *closure)
+{
+  double *result = closure;
+  *result = bench_accessor (access_mod1);
+  return NULL;
+}
+
+static int
+do_test (void)
+{
+  void *mod1 = xdlopen (OBJPFX "bench-tls-access-mod1.so", RTLD_NOW);
+  access_mod1 = xdlsym (mod1, "bench_tls_access_mod1");
+
+  json_ctx_t json_ctx;
+  json_init (&json_ctx, 0, stdout);
+
+  json_document_begin (&json_ctx);
+  json_attr_string (&json_ctx, "timing_type", TIMING_TYPE);
+  json_attr_object_begin (&json_ctx, "functions");
+  json_attr_object_begin (&json_ctx, "tls-access");
+
+  json_attr_double (&json_ctx, "dlopen", bench_accessor (access_mod1));
+
+  void *mod2 = xdlopen (OBJPFX "bench-tls-access-mod2.so", RTLD_NOW);
+  accessor_t access_mod2 = xdlsym (mod2, "bench_tls_access_mod2");
+  json_attr_double (&json_ctx, "after-unrelated-dlopen",
+		    bench_accessor (access_mod1));
+  json_attr_double (&json_ctx, "second-module", bench_accessor (access_mod2));
+
+  double thread_result;
+  xpthread_join (xpthread_create (NULL, thread_func, &thread_result));
+  json_attr_double (&json_ctx, "new-thread", thread_result);
+
+  json_attr_object_end (&json_ctx);
+  json_attr_object_end (&json_ctx);
+  json_document_end (&json_ctx);
+
+  xdlclose (mod2);
+  xdlclose (mod1);
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -2,5 +2,14 @@
 #define FORMAT1 "   %1$d: %2$c%3$c%4$c%5$c%6$c %7$20s %8$f (%9$02x)\n"
 /* A matching, but arbitrarily selected, set of non-positional format specifiers.  */
 #define FORMAT2 "   %d: %c%c%c%c%c %20s %f (%02x)\n"
+/* Floating-point heavy format specifiers, which use the same arguments
+   as the above but print all of the floating-point values.  */
+#define FORMAT3 "%d%c%c%c%c%c%.0s %f %x %.2f %f %.1f %.10f\n"
+#define FORMAT4 "%d%c%c%c%c%c%.0s %e %x %e %.3e %.12e %.0e\n"
+#define FORMAT5 "%d%c%c%c%c%c%.0s %g %x %g %.3g %.17g %#g\n"
+/* Positional format specifiers which refer to all of the arguments,
+   with more conversions to parse than the above.  */
+#define FORMAT6 "%1$d %7$s %9$#x %2$c%3$c%4$c%5$c%6$c %8$.1f %10$.2f " \
+  "%11$e %12$.3g %13$g\n"
 /* Sufficiently large buffer.  */
 char buf[256];
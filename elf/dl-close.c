@@ -17,6 +17,7 @@
    <https://www.gnu.org/licenses/>.  */
 
 #include <assert.h>
+#include <atomic.h>
 #include <dlfcn.h>
 #include <errno.h>
 #include <libintl.h>
@@ -33,6 +34,7 @@
 #include <tls.h>
 #include <stap-probe.h>
 #include <dl-find_object.h>
+#include <dl-ifunc-cache.h>
 
 #include <dl-unmap-segments.h>
 
@@ -616,6 +618,11 @@ _dl_close_worker (struct link_map *map, bool force)
 	     the `munmap' call does the rest.  */
 	  DL_UNMAP (imap);
 
+#ifdef SHARED
+	  /* Cached IFUNC results may point into the unmapped object.  */
+	  _dl_ifunc_cache_clear ();
+#endif
+
 	  /* Finally, unlink the data structure and free it.  */
 #if DL_NNS == 1
 	  /* The assert in the (imap->l_prev == NULL) case gives
@@ -640,6 +647,12 @@ _dl_close_worker (struct link_map *map, bool force)
 	    imap->l_prev->l_next = imap->l_next;
 
 	  --ns->_ns_nloaded;
+#if __HAVE_64B_ATOMICS
+	  /* dl_iterate_phdr reads the counter without locking.  */
+	  atomic_store_relaxed (&GL(dl_load_subs), GL(dl_load_subs) + 1);
+#else
+	  ++GL(dl_load_subs);
+#endif
 	  if (imap->l_next != NULL)
 	    imap->l_next->l_prev = imap->l_prev;
 
@@ -651,6 +664,7 @@ _dl_close_worker (struct link_map *map, bool force)
 	    free ((char *) imap->l_origin);
 
 	  free (imap->l_reldeps);
+	  free (imap->l_startup_profile);
 
 	  /* Print debugging message.  */
 	  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_FILES))
@@ -702,8 +716,9 @@ _dl_close_worker (struct link_map *map, bool force)
       size_t newgen = GL(dl_tls_generation) + 1;
       if (__glibc_unlikely (newgen == 0))
 	_dl_fatal_printf ("TLS generation counter wrapped!  Please report as described in "REPORT_BUGS_TO".\n");
-      /* Can be read concurrently.  */
-      atomic_store_relaxed (&GL(dl_tls_generation), newgen);
+      /* Can be read concurrently.  Synchronize with the acquire MO
+	 load in __tls_get_addr.  */
+      atomic_store_release (&GL(dl_tls_generation), newgen);
 
       if (tls_free_end == GL(dl_tls_static_used))
 	GL(dl_tls_static_used) = tls_free_start;
@@ -0,0 +1,103 @@
+/* Reuse IFUNC resolver results during relocation processing.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <dl-ifunc-cache.h>
+#include <dl-irel.h>
+#include <gnu/lib-names.h>
+#include <ldsodefs.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Open-addressing hash table keyed by the resolver address.  A zero
+   key denotes an empty slot.  libc and libm together have a few
+   hundred IFUNC symbols, so the table is sized to stay sparse in
+   typical processes.  Once it is three quarters full, further results
+   are not recorded.  */
+enum { cache_size = 1024 };
+
+static struct
+{
+  ElfW(Addr) resolver;
+  ElfW(Addr) value;
+} cache[cache_size];
+
+static unsigned int cache_used;
+
+unsigned long int _dl_ifunc_cache_hits;
+
+static inline size_t
+cache_hash (ElfW(Addr) addr)
+{
+  /* Resolvers are functions, so the low bits carry little
+     information.  */
+  return ((addr >> 4) * 0x9e3779b97f4a7c15ULL) >> 32;
+}
+
+/* Return true if the results of the resolvers in L can be cached,
+   because L is libc or libm.  */
+static bool
+cacheable_object (struct link_map *l)
+{
+  if (l == GL(dl_ns)[l->l_ns].libc_map)
+    return true;
+  if (l->l_info[DT_SONAME] == NULL)
+    return false;
+  const char *soname = ((const char *) D_PTR (l, l_info[DT_STRTAB])
+			+ l->l_info[DT_SONAME]->d_un.d_val);
+  return strcmp (soname, LIBM_SO) == 0;
+}
+
+ElfW(Addr)
+_dl_ifunc_cache_invoke (struct link_map *l, ElfW(Addr) addr)
+{
+  if (!cacheable_object (l))
+    return elf_ifunc_invoke (addr);
+
+  size_t i = cache_hash (addr) & (cache_size - 1);
+  while (cache[i].resolver != 0)
+    {
+      if (cache[i].resolver == addr)
+	{
+	  ++_dl_ifunc_cache_hits;
+	  return cache[i].value;
+	}
+      i = (i + 1) & (cache_size - 1);
+    }
+
+  ElfW(Addr) value = elf_ifunc_invoke (addr);
+
+  /* Slot I is only used if it is still empty, in case the resolver
+     re-entered the dynamic loader.  */
+  if (cache_used < cache_size / 4 * 3 && cache[i].resolver == 0)
+    {
+      cache[i].resolver = addr;
+      cache[i].value = value;
+      ++cache_used;
+    }
+  return value;
+}
+
+void
+_dl_ifunc_cache_clear (void)
+{
+  if (cache_used != 0)
+    {
+      memset (cache, 0, sizeof (cache));
+      cache_used = 0;
+    }
+}
@@ -0,0 +1,62 @@
+/* Reuse IFUNC resolver results during relocation processing.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _DL_IFUNC_CACHE_H
+#define _DL_IFUNC_CACHE_H
+
+#include <link.h>
+
+/* Every object which binds to an IFUNC symbol in libc or libm calls its
+   resolver again, once per relocation.  The resolvers in these objects
+   only depend on the CPU features and tunables, which do not change
+   during the lifetime of the process, so the dynamic loader remembers
+   their results and calls each of them only once.  Resolvers defined in
+   other objects may return different results on later calls, for
+   example after a constructor has changed state which they read, so
+   they are always called.
+
+   The cache is only used while processing relocations, which happens
+   with the loader lock held (or before any other thread exists), so no
+   further synchronization is needed.  Lazy binding calls the resolvers
+   directly.  */
+#if IS_IN (rtld)
+/* Return the result of the IFUNC resolver at ADDR, defined in the
+   object L.  If L is libc or libm, call the resolver only if it has not
+   been called before.  */
+extern ElfW(Addr) _dl_ifunc_cache_invoke (struct link_map *l,
+					  ElfW(Addr) addr) attribute_hidden;
+
+/* Discard all cached results.  Called after objects have been
+   unloaded, because their addresses may be reused.  */
+extern void _dl_ifunc_cache_clear (void) attribute_hidden;
+
+/* Number of resolver calls avoided, for LD_DEBUG=statistics.  */
+extern unsigned long int _dl_ifunc_cache_hits attribute_hidden;
+#endif
+
+/* Use elf_ifunc_invoke_cached instead of elf_ifunc_invoke (from
+   <dl-irel.h>) in the relocation processing code.  MAP is the object
+   which defines the resolver.  Targets which do so define
+   ELF_MACHINE_IFUNC_CACHE in <dl-machine.h>.  */
+#if IS_IN (rtld) && !defined RTLD_BOOTSTRAP
+# define elf_ifunc_invoke_cached(map, addr) _dl_ifunc_cache_invoke (map, addr)
+#else
+# define elf_ifunc_invoke_cached(map, addr) elf_ifunc_invoke (addr)
+#endif
+
+#endif /* _DL_IFUNC_CACHE_H */
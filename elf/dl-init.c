@@ -20,6 +20,7 @@
 #include <stddef.h>
 #include <ldsodefs.h>
 #include <elf-initfini.h>
+#include <dl-statistics.h>
 
 
 static void
@@ -48,6 +49,9 @@ call_init (struct link_map *l, int argc, char **argv, char **env)
     _dl_debug_printf ("\ncalling init: %s\n\n",
 		      DSO_FILENAME (l->l_name));
 
+  RTLD_TIMING_VAR (start);
+  rtld_timer_start (&start);
+
   /* Now run the local constructors.  There are two forms of them:
      - the one named by DT_INIT
      - the others in the DT_INIT_ARRAY.
@@ -69,6 +73,8 @@ call_init (struct link_map *l, int argc, char **argv, char **env)
       for (j = 0; j < jm; ++j)
 	((dl_init_t) addrs[j]) (argc, argv, env);
     }
+
+  dl_startup_profile_stop (l, dl_startup_init, start);
 }
 
 
@@ -78,6 +84,12 @@ _dl_init (struct link_map *main_map, int argc, char **argv, char **env)
   ElfW(Dyn) *preinit_array = main_map->l_info[DT_PREINIT_ARRAY];
   ElfW(Dyn) *preinit_array_size = main_map->l_info[DT_PREINIT_ARRAYSZ];
   unsigned int i;
+#if DL_STARTUP_PROFILE
+  /* Only the initialization of the objects loaded at startup ends the
+     startup profile, not a later dlopen of the main program.  */
+  bool startup = (main_map == GL(dl_ns)[LM_ID_BASE]._ns_loaded
+		  && !main_map->l_init_called);
+#endif
 
   if (__glibc_unlikely (GL(dl_initfirst) != NULL))
     {
@@ -97,9 +109,12 @@ _dl_init (struct link_map *main_map, int argc, char **argv, char **env)
 	_dl_debug_printf ("\ncalling preinit: %s\n\n",
 			  DSO_FILENAME (main_map->l_name));
 
+      RTLD_TIMING_VAR (start);
+      rtld_timer_start (&start);
       addrs = (ElfW(Addr) *) (preinit_array->d_un.d_ptr + main_map->l_addr);
       for (cnt = 0; cnt < i; ++cnt)
 	((dl_init_t) addrs[cnt]) (argc, argv, env);
+      dl_startup_profile_stop (main_map, dl_startup_init, start);
     }
 
   /* Stupid users forced the ELF specification to be changed.  It now
@@ -116,6 +131,11 @@ _dl_init (struct link_map *main_map, int argc, char **argv, char **env)
   while (i-- > 0)
     call_init (main_map->l_initfini[i], argc, argv, env);
 
+#if DL_STARTUP_PROFILE
+  if (startup && dl_startup_profile_enabled ())
+    _dl_startup_profile_report ();
+#endif
+
 #ifndef HAVE_INLINED_SYSCALLS
   /* Finished starting up.  */
   _dl_starting_up = 0;
@@ -16,6 +16,7 @@
    License along with the GNU C Library; see the file COPYING.LIB.  If
    not, see <https://www.gnu.org/licenses/>.  */
 
+#include <atomic.h>
 #include <errno.h>
 #include <ldsodefs.h>
 #include <stddef.h>
@@ -27,6 +28,79 @@ cancel_handler (void *arg __attribute__((unused)))
   __rtld_lock_unlock_recursive (GL(dl_load_write_lock));
 }
 
+/* Fill in *INFO for the link map L.  */
+static void
+fill_phdr_info (struct dl_phdr_info *info, struct link_map *l,
+		unsigned long long int adds, unsigned long long int subs)
+{
+  info->dlpi_addr = l->l_real->l_addr;
+  info->dlpi_name = l->l_real->l_name;
+  info->dlpi_phdr = l->l_real->l_phdr;
+  info->dlpi_phnum = l->l_real->l_phnum;
+  info->dlpi_adds = adds;
+  info->dlpi_subs = subs;
+  info->dlpi_tls_data = NULL;
+  info->dlpi_tls_modid = l->l_real->l_tls_modid;
+  if (info->dlpi_tls_modid != 0)
+    info->dlpi_tls_data = GLRO(dl_tls_get_addr_soft) (l->l_real);
+}
+
+#if __HAVE_64B_ATOMICS
+/* Report the objects loaded during startup without acquiring
+   GL(dl_load_write_lock).  They can never be unloaded, and the part of
+   the base namespace list which links them is not modified after
+   startup, so no synchronization with dlopen and dlclose is needed.
+   This is the common case for unwinders, whose callbacks usually stop
+   the iteration at the object containing the program counter.  Stores
+   the number of objects reported in *REPORTED.  Returns the last
+   callback result.  */
+static int
+iterate_initial_objects (int (*callback) (struct dl_phdr_info *info,
+					  size_t size, void *data),
+			 void *data, const void *caller, size_t *reported)
+{
+  unsigned int initial = GL(dl_initial_nloaded);
+  if (initial == 0)
+    /* Startup has not completed yet.  */
+    return 0;
+
+# ifdef SHARED
+  /* Only the base namespace is reported without locking.  If there
+     are other namespaces, the caller may reside in one of them.  */
+  if (atomic_load_relaxed (&GL(dl_nns)) > 1)
+    {
+      struct dl_find_object dlfo;
+      if (GLRO(dl_find_object) ((void *) caller, &dlfo) == 0
+	  && dlfo.dlfo_link_map->l_ns != LM_ID_BASE)
+	return 0;
+    }
+# endif
+
+  /* The counters are not read consistently with each other, but both
+     are monotonic, so a change in the set of loaded objects is still
+     reflected in at least one of them.  */
+  unsigned long long int adds = atomic_load_relaxed (&GL(dl_load_adds));
+  unsigned long long int subs = atomic_load_relaxed (&GL(dl_load_subs));
+
+  struct dl_phdr_info info;
+  int ret = 0;
+  struct link_map *l = GL(dl_ns)[LM_ID_BASE]._ns_loaded;
+  for (unsigned int i = 0; i < initial; ++i)
+    {
+      /* Do not read the l_next member of the last initial object.  It
+	 is updated concurrently by dlopen and dlclose.  */
+      if (i > 0)
+	l = l->l_next;
+      fill_phdr_info (&info, l, adds, subs);
+      ret = callback (&info, sizeof (struct dl_phdr_info), data);
+      ++*reported;
+      if (ret)
+	break;
+    }
+  return ret;
+}
+#endif /* __HAVE_64B_ATOMICS */
+
 int
 __dl_iterate_phdr (int (*callback) (struct dl_phdr_info *info,
 				    size_t size, void *data), void *data)
@@ -34,6 +108,16 @@ __dl_iterate_phdr (int (*callback) (struct dl_phdr_info *info,
   struct link_map *l;
   struct dl_phdr_info info;
   int ret = 0;
+  const void *caller __attribute__ ((unused)) = RETURN_ADDRESS (0);
+
+  /* Number of objects at the start of the base namespace list which
+     have already been reported.  */
+  size_t reported = 0;
+#if __HAVE_64B_ATOMICS
+  ret = iterate_initial_objects (callback, data, caller, &reported);
+  if (ret)
+    return ret;
+#endif
 
   /* Make sure nobody modifies the list of loaded objects.  */
   __rtld_lock_lock_recursive (GL(dl_load_write_lock));
@@ -41,16 +125,11 @@ __dl_iterate_phdr (int (*callback) (struct dl_phdr_info *info,
 
   /* We have to determine the namespace of the caller since this determines
      which namespace is reported.  */
-  size_t nloaded = GL(dl_ns)[0]._ns_nloaded;
   Lmid_t ns = 0;
 #ifdef SHARED
-  const void *caller = RETURN_ADDRESS (0);
   for (Lmid_t cnt = GL(dl_nns) - 1; cnt > 0; --cnt)
     for (struct link_map *l = GL(dl_ns)[cnt]._ns_loaded; l; l = l->l_next)
       {
-	/* We have to count the total number of loaded objects.  */
-	nloaded += GL(dl_ns)[cnt]._ns_nloaded;
-
 	if (caller >= (const void *) l->l_map_start
 	    && caller < (const void *) l->l_map_end
 	    && (l->l_contiguous
@@ -59,18 +138,22 @@ __dl_iterate_phdr (int (*callback) (struct dl_phdr_info *info,
       }
 #endif
 
-  for (l = GL(dl_ns)[ns]._ns_loaded; l != NULL; l = l->l_next)
+  l = GL(dl_ns)[ns]._ns_loaded;
+  if (ns == LM_ID_BASE)
+    /* Skip the objects reported without locking.  */
+    for (; reported > 0 && l != NULL; --reported)
+      l = l->l_next;
+
+  for (; l != NULL; l = l->l_next)
     {
-      info.dlpi_addr = l->l_real->l_addr;
-      info.dlpi_name = l->l_real->l_name;
-      info.dlpi_phdr = l->l_real->l_phdr;
-      info.dlpi_phnum = l->l_real->l_phnum;
-      info.dlpi_adds = GL(dl_load_adds);
-      info.dlpi_subs = GL(dl_load_adds) - nloaded;
-      info.dlpi_tls_data = NULL;
-      info.dlpi_tls_modid = l->l_real->l_tls_modid;
-      if (info.dlpi_tls_modid != 0)
-	info.dlpi_tls_data = GLRO(dl_tls_get_addr_soft) (l->l_real);
+      /* The counters are written atomically because of the readers in
+	 iterate_initial_objects, so read them the same way.  */
+#if __HAVE_64B_ATOMICS
+      fill_phdr_info (&info, l, atomic_load_relaxed (&GL(dl_load_adds)),
+		      atomic_load_relaxed (&GL(dl_load_subs)));
+#else
+      fill_phdr_info (&info, l, GL(dl_load_adds), GL(dl_load_subs));
+#endif
       ret = callback (&info, sizeof (struct dl_phdr_info), data);
       if (ret)
 	break;
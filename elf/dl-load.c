@@ -72,6 +72,7 @@ struct filebuf
 #include <dl-map-segments.h>
 #include <dl-unmap-segments.h>
 #include <dl-machine-reject-phdr.h>
+#include <dl-statistics.h>
 #include <dl-sysdep-open.h>
 #include <dl-prop.h>
 #include <not-cancel.h>
@@ -98,6 +99,9 @@ int __stack_prot attribute_hidden attribute_relro
   = 0;
 #endif
 
+/* Counters for LD_DEBUG=statistics.  */
+struct dl_load_statistics _dl_load_statistics;
+
 
 /* This is the decomposed LD_LIBRARY_PATH search path.  */
 struct r_search_path_struct __rtld_env_path_list attribute_relro;
@@ -1482,6 +1486,7 @@ cannot enable executable stack as shared object requires");
 
   /* Now that the object is fully initialized add it to the object list.  */
   _dl_add_to_namespace_list (l, nsid);
+  ++_dl_load_statistics.objects;
 
   /* Skip auditing and debugger notification when called from 'sprof'.  */
   if (mode & __RTLD_SPROF)
@@ -1618,11 +1623,19 @@ open_verify (const char *name, int fd,
     }
 #endif
 
+  RTLD_TIMING_VAR (start);
+  rtld_timer_start (&start);
+
   if (fd == -1)
-    /* Open the file.  We always open files read-only.  */
-    fd = __open64_nocancel (name, O_RDONLY | O_CLOEXEC);
+    {
+      /* Open the file.  We always open files read-only.  */
+      fd = __open64_nocancel (name, O_RDONLY | O_CLOEXEC);
+      ++_dl_load_statistics.open_attempts;
+    }
 
-  if (fd != -1)
+  if (fd == -1)
+    rtld_timer_accum (&_dl_load_statistics.open_time, start);
+  else
     {
       ElfW(Ehdr) *ehdr;
       ElfW(Phdr) *phdr;
@@ -1643,6 +1656,7 @@ open_verify (const char *name, int fd,
 	  fbp->len += retlen;
 	}
       while (__glibc_unlikely (fbp->len < sizeof (ElfW(Ehdr))));
+      rtld_timer_accum (&_dl_load_statistics.open_time, start);
 
       /* This is where the ELF header is loaded.  */
       ehdr = (ElfW(Ehdr) *) fbp->buf;
@@ -1983,6 +1997,14 @@ _dl_map_object (struct link_map *loader, const char *name,
       return l;
     }
 
+  /* The object has to be loaded.  Measure the time spent on finding
+     the file separately from the time spent on mapping it.  */
+  RTLD_TIMING_VAR (start);
+  rtld_timer_start (&start);
+#if DL_STARTUP_PROFILE
+  hp_timing_t open_time = _dl_load_statistics.open_time;
+#endif
+
   /* Display information if we are debugging.  */
   if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_FILES)
       && loader != NULL)
@@ -2242,9 +2264,29 @@ _dl_map_object (struct link_map *loader, const char *name,
 			  N_("cannot open shared object file"));
     }
 
+#if DL_STARTUP_PROFILE
+  hp_timing_t search_time;
+  rtld_timer_stop (&search_time, start);
+  open_time = _dl_load_statistics.open_time - open_time;
+#endif
+  rtld_timer_accum (&_dl_load_statistics.search_time, start);
+
   void *stack_end = __libc_stack_end;
-  return _dl_map_object_from_fd (name, origname, fd, &fb, realname, loader,
-				 type, mode, &stack_end, nsid);
+  rtld_timer_start (&start);
+  l = _dl_map_object_from_fd (name, origname, fd, &fb, realname, loader,
+			      type, mode, &stack_end, nsid);
+  rtld_timer_accum (&_dl_load_statistics.map_time, start);
+
+  /* With RTLD_NOLOAD, no object is returned.  */
+#if DL_STARTUP_PROFILE
+  if (dl_startup_profile_enabled () && l != NULL)
+    {
+      _dl_startup_profile_add (l, dl_startup_search, search_time - open_time);
+      _dl_startup_profile_add (l, dl_startup_open, open_time);
+      dl_startup_profile_stop (l, dl_startup_map, start);
+    }
+#endif
+  return l;
 }
 
 struct add_path_state
@@ -16,6 +16,7 @@
    License along with the GNU C Library; if not, see
    <https://www.gnu.org/licenses/>.  */
 
+#include <atomic.h>
 #include <errno.h>
 #include <string.h>
 #include <stdlib.h>
@@ -45,7 +46,12 @@ _dl_add_to_namespace_list (struct link_map *new, Lmid_t nsid)
     GL(dl_ns)[nsid]._ns_loaded = new;
   ++GL(dl_ns)[nsid]._ns_nloaded;
   new->l_serial = GL(dl_load_adds);
+#if __HAVE_64B_ATOMICS
+  /* dl_iterate_phdr reads the counter without locking.  */
+  atomic_store_relaxed (&GL(dl_load_adds), GL(dl_load_adds) + 1);
+#else
   ++GL(dl_load_adds);
+#endif
 
   __rtld_lock_unlock_recursive (GL(dl_load_write_lock));
 }
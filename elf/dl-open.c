@@ -37,6 +37,7 @@
 #include <libc-early-init.h>
 #include <gnu/lib-names.h>
 #include <dl-find_object.h>
+#include <dl-statistics.h>
 
 #include <dl-dst.h>
 #include <dl-prop.h>
@@ -74,6 +75,16 @@ struct dl_open_args
   int argc;
   char **argv;
   char **env;
+
+  /* Data for LD_DEBUG=statistics: the loader counters at the start of
+     dl_open_worker_begin, and the time spent in the later phases.  */
+  struct dl_load_statistics load_statistics;
+  unsigned long long int load_adds;
+#if HP_TIMING_INLINE
+  hp_timing_t version_time;
+  hp_timing_t relocate_time;
+  hp_timing_t init_time;
+#endif
 };
 
 /* Called in case the global scope cannot be extended.  */
@@ -404,8 +415,10 @@ update_tls_slotinfo (struct link_map *new)
   if (__glibc_unlikely (newgen == 0))
     _dl_fatal_printf (N_("\
 TLS generation counter wrapped!  Please report this."));
-  /* Can be read concurrently.  */
-  atomic_store_relaxed (&GL(dl_tls_generation), newgen);
+  /* Can be read concurrently.  Synchronize with the acquire MO load in
+     __tls_get_addr, so that the slotinfo updates above are visible
+     to threads which observe the new generation.  */
+  atomic_store_release (&GL(dl_tls_generation), newgen);
 
   /* We need a second pass for static tls data, because
      _dl_update_slotinfo must not be run while calls to
@@ -431,7 +444,7 @@ TLS generation counter wrapped!  Please report this."));
 	     _dl_update_slotinfo would have to be split into two
 	     operations, similar to resize_scopes and update_scopes
 	     above.  This is related to bug 16134.  */
-	  _dl_update_slotinfo (imap->l_tls_modid);
+	  _dl_update_slotinfo (imap->l_tls_modid, GL(dl_tls_generation));
 #endif
 
 	  dl_init_static_tls (imap);
@@ -529,6 +542,9 @@ dl_open_worker_begin (void *a)
      may not be true if this is a recursive call to dlopen.  */
   _dl_debug_initialize (0, args->nsid);
 
+  args->load_statistics = _dl_load_statistics;
+  args->load_adds = GL(dl_load_adds);
+
   /* Load the named object.  */
   struct link_map *new;
   args->map = new = _dl_map_object (call_map, file, lt_loaded, 0,
@@ -595,6 +611,8 @@ dl_open_worker_begin (void *a)
 		       mode & (__RTLD_DLOPEN | RTLD_DEEPBIND | __RTLD_AUDIT));
 
   /* So far, so good.  Now check the versions.  */
+  RTLD_TIMING_VAR (start);
+  rtld_timer_start (&start);
   for (unsigned int i = 0; i < new->l_searchlist.r_nlist; ++i)
     if (new->l_searchlist.r_list[i]->l_real->l_versions == NULL)
       {
@@ -611,6 +629,7 @@ dl_open_worker_begin (void *a)
 	  __rtld_static_init (map);
 #endif
       }
+  rtld_timer_stop (&args->version_time, start);
 
 #ifdef SHARED
   /* Auditing checkpoint: we have added all objects.  */
@@ -655,6 +674,7 @@ dl_open_worker_begin (void *a)
   while (l != NULL);
 
   int relocation_in_progress = 0;
+  rtld_timer_start (&start);
 
   /* Perform relocation.  This can trigger lazy binding in IFUNC
      resolvers.  For NODELETE mappings, these dependencies are not
@@ -703,6 +723,7 @@ dl_open_worker_begin (void *a)
 #endif
 	_dl_relocate_object (l, l->l_scope, reloc_mode, 0);
     }
+  rtld_timer_stop (&args->relocate_time, start);
 
   /* This only performs the memory allocations.  The actual update of
      the scopes happens below, after failure is impossible.  */
@@ -769,6 +790,45 @@ dl_open_worker_begin (void *a)
   args->worker_continue = true;
 }
 
+#if HP_TIMING_INLINE
+static void
+print_statistics_item (const char *title, hp_timing_t time)
+{
+  char cycles[HP_TIMING_PRINT_SIZE];
+  HP_TIMING_PRINT (cycles, sizeof (cycles), time);
+  _dl_debug_printf ("%s: %s cycles\n", title, cycles);
+}
+#endif
+
+/* Print the phases of the dlopen call described by ARGS for
+   LD_DEBUG=statistics.  */
+static void
+print_statistics (struct dl_open_args *args)
+{
+  const struct dl_load_statistics *before = &args->load_statistics;
+  _dl_debug_printf ("\ndlopen statistics for %s [%lu]:\n"
+		    "            number of objects loaded: %llu\n"
+		    "            number of objects mapped: %lu\n"
+		    "    number of files opened in search: %lu\n",
+		    args->map->l_name, args->map->l_ns,
+		    GL(dl_load_adds) - args->load_adds,
+		    _dl_load_statistics.objects - before->objects,
+		    _dl_load_statistics.open_attempts - before->open_attempts);
+#if HP_TIMING_INLINE
+  print_statistics_item ("       time needed to search objects",
+			 _dl_load_statistics.search_time
+			 - before->search_time);
+  print_statistics_item ("          time needed to map objects",
+			 _dl_load_statistics.map_time - before->map_time);
+  print_statistics_item ("      time needed for version checks",
+			 args->version_time);
+  print_statistics_item ("          time needed for relocation",
+			 args->relocate_time);
+  print_statistics_item ("        time needed for initializers",
+			 args->init_time);
+#endif
+}
+
 static void
 dl_open_worker (void *a)
 {
@@ -807,7 +867,10 @@ dl_open_worker (void *a)
         .argv = args->argv,
         .env = args->env
       };
+    RTLD_TIMING_VAR (start);
+    rtld_timer_start (&start);
     _dl_catch_exception (NULL, call_dl_init, &init_args);
+    rtld_timer_stop (&args->init_time, start);
   }
 
   /* Now we can make the new map available in the global scope.  */
@@ -818,6 +881,9 @@ dl_open_worker (void *a)
   if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_FILES))
     _dl_debug_printf ("opening file=%s [%lu]; direct_opencount=%u\n\n",
 		      new->l_name, new->l_ns, new->l_direct_opencount);
+
+  if (__glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_STATISTICS))
+    print_statistics (args);
 }
 
 void *
@@ -27,6 +27,7 @@
 #include <sys/types.h>
 #include <_itoa.h>
 #include <libc-pointer-arith.h>
+#include <dl-statistics.h>
 #include "dynamic-link.h"
 
 /* Statistics function.  */
@@ -116,7 +117,8 @@ _dl_try_allocate_static_tls (struct link_map *map, bool optional)
 			    0))
 	/* Update the slot information data for at least the generation of
 	   the DSO we are allocating data for.  */
-	(void) _dl_update_slotinfo (map->l_tls_modid);
+	(void) _dl_update_slotinfo (map->l_tls_modid,
+				    GL(dl_tls_generation));
 #endif
 
       dl_init_static_tls (map);
@@ -245,6 +247,9 @@ _dl_relocate_object (struct link_map *l, struct r_scope_elem *scope[],
   if (l->l_relocated)
     return;
 
+  RTLD_TIMING_VAR (start);
+  rtld_timer_start (&start);
+
   /* If DT_BIND_NOW is set relocate all references in this object.  We
      do not do this if we are profiling, of course.  */
   // XXX Correct for auditing?
@@ -347,6 +352,8 @@ _dl_relocate_object (struct link_map *l, struct r_scope_elem *scope[],
      done, do it.  */
   if (l->l_relro_size != 0)
     _dl_protect_relro (l);
+
+  dl_startup_profile_stop (l, dl_startup_relocate, start);
 }
 
 
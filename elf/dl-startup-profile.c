@@ -0,0 +1,126 @@
+/* Per-object startup profile for LD_DEBUG=profile-startup.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <_itoa.h>
+#include <dl-statistics.h>
+#include <ldsodefs.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#if DL_STARTUP_PROFILE
+
+/* Set once the profile has been written.  Objects which are loaded
+   afterwards, by dlopen, are not profiled.  */
+static bool profile_written;
+
+/* Names of the phases in the JSON output, indexed by enum
+   dl_startup_phase.  */
+static const char phase_names[dl_startup_nphases][10] =
+  {
+    [dl_startup_search] = "search",
+    [dl_startup_open] = "open",
+    [dl_startup_map] = "map",
+    [dl_startup_version] = "version",
+    [dl_startup_relocate] = "relocate",
+    [dl_startup_irelative] = "irelative",
+    [dl_startup_init] = "init",
+  };
+
+void
+_dl_startup_profile_add (struct link_map *l, enum dl_startup_phase phase,
+			 hp_timing_t time)
+{
+  if (profile_written)
+    return;
+
+  if (l->l_startup_profile == NULL)
+    {
+      l->l_startup_profile = calloc (1, sizeof (*l->l_startup_profile));
+      /* The profile is best-effort.  Do not fail the load.  */
+      if (l->l_startup_profile == NULL)
+	return;
+    }
+  HP_TIMING_ACCUM_NT (l->l_startup_profile->times[phase], time);
+}
+
+/* Write S as a JSON string to FD.  */
+static void
+print_json_string (int fd, const char *s)
+{
+  _dl_dprintf (fd, "\"");
+  while (*s != '\0')
+    {
+      size_t len = 0;
+      while (s[len] != '\0' && s[len] != '"' && s[len] != '\\'
+	     && (unsigned char) s[len] >= ' ')
+	++len;
+      if (len > 0)
+	_dl_dprintf (fd, "%.*s", (int) len, s);
+      s += len;
+
+      if (*s == '"' || *s == '\\')
+	_dl_dprintf (fd, "\\%.*s", 1, s++);
+      else if (*s != '\0')
+	_dl_dprintf (fd, "\\u%0*x", 4, (unsigned int) (unsigned char) *s++);
+    }
+  _dl_dprintf (fd, "\"");
+}
+
+/* The output uses the layout of the benchtests JSON documents, so that
+   it can be processed with the same tools.  All times are in
+   hp_timing_t units.  */
+void
+_dl_startup_profile_report (void)
+{
+  if (profile_written)
+    return;
+  profile_written = true;
+
+  int fd = GLRO(dl_debug_fd);
+  _dl_dprintf (fd, "{\n \"timing_type\": \"hp_timing\",\n \"objects\": [");
+
+  bool first = true;
+  for (Lmid_t ns = 0; ns < GL(dl_nns); ++ns)
+    for (struct link_map *l = GL(dl_ns)[ns]._ns_loaded; l != NULL;
+	 l = l->l_next)
+      {
+	_dl_dprintf (fd, "%s\n  {\n   \"name\": ", first ? "" : ",");
+	first = false;
+	print_json_string (fd, DSO_FILENAME (l->l_name));
+	_dl_dprintf (fd, ",\n   \"namespace\": %lu", l->l_ns);
+
+	for (int i = 0; i < dl_startup_nphases; ++i)
+	  {
+	    hp_timing_t time = 0;
+	    if (l->l_startup_profile != NULL)
+	      time = l->l_startup_profile->times[i];
+
+	    char buf[3 * sizeof (hp_timing_t) + 1];
+	    buf[sizeof (buf) - 1] = '\0';
+	    _dl_dprintf (fd, ",\n   \"%s\": %s", phase_names[i],
+			 _itoa (time, &buf[sizeof (buf) - 1], 10, 0));
+	  }
+	_dl_dprintf (fd, "\n  }");
+      }
+
+  _dl_dprintf (fd, "\n ],\n \"objects_mapped\": %lu,\n"
+	       " \"files_opened\": %lu\n}\n",
+	       _dl_load_statistics.objects, _dl_load_statistics.open_attempts);
+}
+
+#endif /* DL_STARTUP_PROFILE */
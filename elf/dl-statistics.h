@@ -0,0 +1,160 @@
+/* Data collected for LD_DEBUG=statistics and LD_DEBUG=profile-startup.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _DL_STATISTICS_H
+#define _DL_STATISTICS_H
+
+#include <hp-timing.h>
+#include <ldsodefs.h>
+
+/* Only enables rtld profiling for architectures which provides non generic
+   hp-timing support.  The generic support requires either syscall
+   (clock_gettime), which will incur in extra overhead on loading time.
+   Using vDSO is also an option, but it will require extra support on loader
+   to setup the vDSO pointer before its usage.  */
+#if HP_TIMING_INLINE
+# define RLTD_TIMING_DECLARE(var, classifier,...) \
+  classifier hp_timing_t var __VA_ARGS__
+# define RTLD_TIMING_VAR(var)        RLTD_TIMING_DECLARE (var, )
+# define RTLD_TIMING_SET(var, value) (var) = (value)
+# define RTLD_TIMING_REF(var)        &(var)
+
+static inline void
+rtld_timer_start (hp_timing_t *var)
+{
+  HP_TIMING_NOW (*var);
+}
+
+static inline void
+rtld_timer_stop (hp_timing_t *var, hp_timing_t start)
+{
+  hp_timing_t stop;
+  HP_TIMING_NOW (stop);
+  HP_TIMING_DIFF (*var, start, stop);
+}
+
+static inline void
+rtld_timer_accum (hp_timing_t *sum, hp_timing_t start)
+{
+  hp_timing_t stop;
+  rtld_timer_stop (&stop, start);
+  HP_TIMING_ACCUM_NT(*sum, stop);
+}
+#else
+# define RLTD_TIMING_DECLARE(var, classifier...)
+# define RTLD_TIMING_SET(var, value)
+# define RTLD_TIMING_VAR(var)
+# define RTLD_TIMING_REF(var)			 0
+# define rtld_timer_start(var)
+# define rtld_timer_stop(var, start)
+# define rtld_timer_accum(sum, start)
+#endif
+
+/* Counters for the phases of loading an object, maintained by
+   _dl_map_object.  They cover both the objects loaded at startup and
+   those loaded by dlopen.  */
+struct dl_load_statistics
+{
+  /* Number of objects which have been mapped from files.  */
+  unsigned long int objects;
+  /* Number of files which have been opened while searching for
+     objects, including failed attempts in search path directories.  */
+  unsigned long int open_attempts;
+#if HP_TIMING_INLINE
+  /* Time spent searching for and opening files, and verifying their
+     ELF headers.  */
+  hp_timing_t search_time;
+  /* The part of search_time spent in the open and read system calls
+     for candidate files.  */
+  hp_timing_t open_time;
+  /* Time spent mapping the segments of the objects and processing
+     their dynamic sections.  */
+  hp_timing_t map_time;
+#endif
+};
+
+extern struct dl_load_statistics _dl_load_statistics attribute_hidden;
+
+/* Phases of loading and initializing an object which are timed for
+   LD_DEBUG=profile-startup.  */
+enum dl_startup_phase
+  {
+    /* Searching the search path, except for opening files.  */
+    dl_startup_search,
+    /* Opening candidate files and reading their ELF headers.  */
+    dl_startup_open,
+    /* Mapping the segments and processing the dynamic section.  */
+    dl_startup_map,
+    /* Checking the symbol version requirements.  */
+    dl_startup_version,
+    /* Processing relocations, including the IRELATIVE ones below.  */
+    dl_startup_relocate,
+    /* Calling IFUNC resolvers for IRELATIVE relocations.  */
+    dl_startup_irelative,
+    /* Running the ELF constructors.  This includes the time spent in
+       dlopen calls made by the constructors.  */
+    dl_startup_init,
+    dl_startup_nphases
+  };
+
+/* The startup profile is only collected by the dynamic loader, and only
+   if precise timing is available.  */
+#if defined SHARED && HP_TIMING_INLINE
+# define DL_STARTUP_PROFILE 1
+
+/* Per-object data for LD_DEBUG=profile-startup, allocated on demand
+   and pointed to by the l_startup_profile member of struct link_map.  */
+struct dl_startup_profile
+{
+  hp_timing_t times[dl_startup_nphases];
+};
+
+/* Add TIME to PHASE of object L.  Does nothing once the profile has
+   been written.  */
+extern void _dl_startup_profile_add (struct link_map *l,
+				     enum dl_startup_phase phase,
+				     hp_timing_t time) attribute_hidden;
+
+/* Write the profile of all loaded objects as a JSON document to the
+   debug output.  Called once, after the initial objects have been
+   initialized.  */
+extern void _dl_startup_profile_report (void) attribute_hidden;
+
+# define dl_startup_profile_enabled() \
+  __glibc_unlikely (GLRO(dl_debug_mask) & DL_DEBUG_PROFILE_STARTUP)
+
+/* Add the time elapsed since START to PHASE of object L if
+   LD_DEBUG=profile-startup is active.  */
+static inline void
+dl_startup_profile_stop (struct link_map *l, enum dl_startup_phase phase,
+			 hp_timing_t start)
+{
+  if (dl_startup_profile_enabled ())
+    {
+      hp_timing_t time;
+      rtld_timer_stop (&time, start);
+      _dl_startup_profile_add (l, phase, time);
+    }
+}
+#else
+# define DL_STARTUP_PROFILE 0
+# define dl_startup_profile_enabled() false
+# define dl_startup_profile_stop(l, phase, start)
+#endif
+
+#endif /* _DL_STATISTICS_H */
@@ -120,6 +120,12 @@ size_t _dl_nns = 1;
 /* Incremented whenever something may have been added to dl_loaded. */
 unsigned long long _dl_load_adds = 1;
 
+/* Incremented whenever an object has been removed from dl_loaded.  */
+unsigned long long _dl_load_subs;
+
+/* Number of objects loaded during startup.  */
+unsigned int _dl_initial_nloaded;
+
 /* Fake scope of the main application.  */
 struct r_scope_elem _dl_initial_searchlist =
   {
@@ -344,6 +350,9 @@ _dl_non_dynamic_init (void)
 
   call_function_static_weak (_dl_find_object_init);
 
+  /* The objects on the list so far can never be unloaded.  */
+  _dl_initial_nloaded = _dl_ns[LM_ID_BASE]._ns_nloaded;
+
   /* Setup relro on the binary itself.  */
   if (_dl_main_map.l_relro_size != 0)
     _dl_protect_relro (&_dl_main_map);
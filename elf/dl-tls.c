@@ -715,36 +715,29 @@ allocate_and_init (struct link_map *map)
 
 
 struct link_map *
-_dl_update_slotinfo (unsigned long int req_modid)
+_dl_update_slotinfo (unsigned long int req_modid, size_t new_gen)
 {
   struct link_map *the_map = NULL;
   dtv_t *dtv = THREAD_DTV ();
 
   /* The global dl_tls_dtv_slotinfo array contains for each module
-     index the generation counter current when the entry was created.
+     index the generation counter current when the entry was updated.
      This array never shrinks so that all module indices which were
-     valid at some time can be used to access it.  Before the first
-     use of a new module index in this function the array was extended
-     appropriately.  Access also does not have to be guarded against
-     modifications of the array.  It is assumed that pointer-size
-     values can be read atomically even in SMP environments.  It is
-     possible that other threads at the same time dynamically load
-     code and therefore add to the slotinfo list.  This is a problem
-     since we must not pick up any information about incomplete work.
-     The solution to this is to ignore all dtv slots which were
-     created after the one we are currently interested.  We know that
-     dynamic loading for this module is completed and this is the last
-     load operation we know finished.  */
-  unsigned long int idx = req_modid;
-  struct dtv_slotinfo_list *listp = GL(dl_tls_dtv_slotinfo_list);
-
-  while (idx >= listp->len)
-    {
-      idx -= listp->len;
-      listp = listp->next;
-    }
-
-  if (dtv[0].counter < listp->slotinfo[idx].gen)
+     valid at some time can be used to access it.  Concurrent dlopen
+     and dlclose calls can update slotinfo entries or extend the
+     array.  The updates happen under GL(dl_load_tls_lock) and finish
+     with the release MO store of the new generation counter to
+     GL(dl_tls_generation), which synchronizes with the load of NEW_GEN
+     in the caller.  So updates up to NEW_GEN are visible here, but
+     updates for later generations may be incomplete and must be
+     ignored.
+
+     The DTV is brought up to date with NEW_GEN, and not just with the
+     generation of the requested module.  Otherwise every later access
+     to any module would have to take this slow path again as long as
+     the global generation counter is ahead of dtv[0].counter, for
+     example after an unrelated module with TLS was loaded.  */
+  if (dtv[0].counter < new_gen)
     {
       /* CONCURRENCY NOTES:
 
@@ -765,13 +758,12 @@ _dl_update_slotinfo (unsigned long int req_modid)
 	 other entries are racy.  However updating a non-relevant dtv
 	 entry does not affect correctness.  For a relevant module m,
 	 max_modid >= modid of m.  */
-      size_t new_gen = listp->slotinfo[idx].gen;
       size_t total = 0;
       size_t max_modid  = atomic_load_relaxed (&GL(dl_tls_max_dtv_idx));
       assert (max_modid >= req_modid);
 
       /* We have to look through the entire dtv slotinfo list.  */
-      listp =  GL(dl_tls_dtv_slotinfo_list);
+      struct dtv_slotinfo_list *listp =  GL(dl_tls_dtv_slotinfo_list);
       do
 	{
 	  for (size_t cnt = total == 0 ? 1 : 0; cnt < listp->len; ++cnt)
@@ -908,9 +900,9 @@ tls_get_addr_tail (GET_ADDR_ARGS, dtv_t *dtv, struct link_map *the_map)
 
 static struct link_map *
 __attribute_noinline__
-update_get_addr (GET_ADDR_ARGS)
+update_get_addr (GET_ADDR_ARGS, size_t gen)
 {
-  struct link_map *the_map = _dl_update_slotinfo (GET_ADDR_MODULE);
+  struct link_map *the_map = _dl_update_slotinfo (GET_ADDR_MODULE, gen);
   dtv_t *dtv = THREAD_DTV ();
 
   void *p = dtv[GET_ADDR_MODULE].pointer.val;
@@ -940,12 +932,15 @@ __tls_get_addr (GET_ADDR_ARGS)
   dtv_t *dtv = THREAD_DTV ();
 
   /* Update is needed if dtv[0].counter < the generation of the accessed
-     module.  The global generation counter is used here as it is easier
-     to check.  Synchronization for the relaxed MO access is guaranteed
-     by user code, see CONCURRENCY NOTES in _dl_update_slotinfo.  */
-  size_t gen = atomic_load_relaxed (&GL(dl_tls_generation));
+     module, but the global generation counter is used here as it is
+     easier to check.  The update brings the DTV to the global
+     generation, so the slow path is taken at most once per thread
+     after each dlopen or dlclose of a module with TLS.  Synchronize
+     with the release MO store in dlopen and dlclose, see also the
+     CONCURRENCY NOTES in _dl_update_slotinfo.  */
+  size_t gen = atomic_load_acquire (&GL(dl_tls_generation));
   if (__glibc_unlikely (dtv[0].counter != gen))
-    return update_get_addr (GET_ADDR_PARAM);
+    return update_get_addr (GET_ADDR_PARAM, gen);
 
   void *p = dtv[GET_ADDR_MODULE].pointer.val;
 
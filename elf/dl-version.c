@@ -23,6 +23,7 @@
 #include <string.h>
 #include <ldsodefs.h>
 #include <_itoa.h>
+#include <dl-statistics.h>
 
 #include <assert.h>
 
@@ -394,8 +395,13 @@ _dl_check_all_versions (struct link_map *map, int verbose, int trace_mode)
   int result = 0;
 
   for (l = map; l != NULL; l = l->l_next)
-    result |= (! l->l_faked
-	       && _dl_check_map_versions (l, verbose, trace_mode));
+    {
+      RTLD_TIMING_VAR (start);
+      rtld_timer_start (&start);
+      result |= (! l->l_faked
+		 && _dl_check_map_versions (l, verbose, trace_mode));
+      dl_startup_profile_stop (l, dl_startup_version, start);
+    }
 
   return result;
 }
@@ -17,6 +17,7 @@
    <https://www.gnu.org/licenses/>.  */
 
 #include <ldsodefs.h>
+#include <dl-statistics.h>
 
 /* This file may be included twice, to define both
    `elf_dynamic_do_rel' and `elf_dynamic_do_rela'.  */
@@ -94,9 +95,14 @@ elf_dynamic_do_Rel (struct link_map *map, struct r_scope_elem *scope[],
 
 # ifdef ELF_MACHINE_IRELATIVE
       if (r2 != NULL)
-	for (; r2 <= end2; ++r2)
-	  if (ELFW(R_TYPE) (r2->r_info) == ELF_MACHINE_IRELATIVE)
-	    elf_machine_lazy_rel (map, scope, l_addr, r2, skip_ifunc);
+	{
+	  RTLD_TIMING_VAR (start);
+	  rtld_timer_start (&start);
+	  for (; r2 <= end2; ++r2)
+	    if (ELFW(R_TYPE) (r2->r_info) == ELF_MACHINE_IRELATIVE)
+	      elf_machine_lazy_rel (map, scope, l_addr, r2, skip_ifunc);
+	  dl_startup_profile_stop (map, dl_startup_irelative, start);
+	}
 # endif
     }
   else
@@ -162,17 +168,22 @@ elf_dynamic_do_Rel (struct link_map *map, struct r_scope_elem *scope[],
 
 #if defined ELF_MACHINE_IRELATIVE
 	  if (r2 != NULL)
-	    for (; r2 <= end2; ++r2)
-	      if (ELFW(R_TYPE) (r2->r_info) == ELF_MACHINE_IRELATIVE)
-		{
-		  ElfW(Half) ndx
-		    = version[ELFW(R_SYM) (r2->r_info)] & 0x7fff;
-		  elf_machine_rel (map, scope, r2,
-				   &symtab[ELFW(R_SYM) (r2->r_info)],
-				   &map->l_versions[ndx],
-				   (void *) (l_addr + r2->r_offset),
-				   skip_ifunc);
-		}
+	    {
+	      RTLD_TIMING_VAR (start);
+	      rtld_timer_start (&start);
+	      for (; r2 <= end2; ++r2)
+		if (ELFW(R_TYPE) (r2->r_info) == ELF_MACHINE_IRELATIVE)
+		  {
+		    ElfW(Half) ndx
+		      = version[ELFW(R_SYM) (r2->r_info)] & 0x7fff;
+		    elf_machine_rel (map, scope, r2,
+				     &symtab[ELFW(R_SYM) (r2->r_info)],
+				     &map->l_versions[ndx],
+				     (void *) (l_addr + r2->r_offset),
+				     skip_ifunc);
+		  }
+	      dl_startup_profile_stop (map, dl_startup_irelative, start);
+	    }
 #endif
 	}
       else
@@ -209,11 +220,17 @@ elf_dynamic_do_Rel (struct link_map *map, struct r_scope_elem *scope[],
 
 # ifdef ELF_MACHINE_IRELATIVE
 	  if (r2 != NULL)
-	    for (; r2 <= end2; ++r2)
-	      if (ELFW(R_TYPE) (r2->r_info) == ELF_MACHINE_IRELATIVE)
-		elf_machine_rel (map, scope, r2, &symtab[ELFW(R_SYM) (r2->r_info)],
-				 NULL, (void *) (l_addr + r2->r_offset),
-				 skip_ifunc);
+	    {
+	      RTLD_TIMING_VAR (start);
+	      rtld_timer_start (&start);
+	      for (; r2 <= end2; ++r2)
+		if (ELFW(R_TYPE) (r2->r_info) == ELF_MACHINE_IRELATIVE)
+		  elf_machine_rel (map, scope, r2,
+				   &symtab[ELFW(R_SYM) (r2->r_info)],
+				   NULL, (void *) (l_addr + r2->r_offset),
+				   skip_ifunc);
+	      dl_startup_profile_stop (map, dl_startup_irelative, start);
+	    }
 # endif
 	}
     }
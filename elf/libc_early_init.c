@@ -22,6 +22,7 @@
 #include <libc-internal.h>
 #include <lowlevellock.h>
 #include <pthread_early_init.h>
+#include <stdio.h>
 #include <sys/single_threaded.h>
 
 #ifdef SHARED
@@ -43,6 +44,9 @@ __libc_early_init (_Bool initial)
 
   __pthread_early_init ();
 
+  call_function_static_weak (_IO_thread_buffering_init);
+  call_function_static_weak (_IO_stats_init);
+
 #if ENABLE_ELISION_SUPPORT
   __lll_elision_init ();
 #endif
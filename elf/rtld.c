@@ -53,6 +53,8 @@
 #include <dl-find_object.h>
 #include <dl-audit-check.h>
 #include <dl-call_tls_init_tp.h>
+#include <dl-statistics.h>
+#include <dl-ifunc-cache.h>
 
 #include <assert.h>
 
@@ -67,49 +69,6 @@
 /* Must include after <dl-machine.h> for DT_MIPS definition.  */
 #include <dl-debug.h>
 
-/* Only enables rtld profiling for architectures which provides non generic
-   hp-timing support.  The generic support requires either syscall
-   (clock_gettime), which will incur in extra overhead on loading time.
-   Using vDSO is also an option, but it will require extra support on loader
-   to setup the vDSO pointer before its usage.  */
-#if HP_TIMING_INLINE
-# define RLTD_TIMING_DECLARE(var, classifier,...) \
-  classifier hp_timing_t var __VA_ARGS__
-# define RTLD_TIMING_VAR(var)        RLTD_TIMING_DECLARE (var, )
-# define RTLD_TIMING_SET(var, value) (var) = (value)
-# define RTLD_TIMING_REF(var)        &(var)
-
-static inline void
-rtld_timer_start (hp_timing_t *var)
-{
-  HP_TIMING_NOW (*var);
-}
-
-static inline void
-rtld_timer_stop (hp_timing_t *var, hp_timing_t start)
-{
-  hp_timing_t stop;
-  HP_TIMING_NOW (stop);
-  HP_TIMING_DIFF (*var, start, stop);
-}
-
-static inline void
-rtld_timer_accum (hp_timing_t *sum, hp_timing_t start)
-{
-  hp_timing_t stop;
-  rtld_timer_stop (&stop, start);
-  HP_TIMING_ACCUM_NT(*sum, stop);
-}
-#else
-# define RLTD_TIMING_DECLARE(var, classifier...)
-# define RTLD_TIMING_SET(var, value)
-# define RTLD_TIMING_VAR(var)
-# define RTLD_TIMING_REF(var)			 0
-# define rtld_timer_start(var)
-# define rtld_timer_stop(var, start)
-# define rtld_timer_accum(sum, start)
-#endif
-
 /* Avoid PLT use for our local calls at startup.  */
 extern __typeof (__mempcpy) __mempcpy attribute_hidden;
 
@@ -2374,6 +2333,11 @@ dl_main (const ElfW(Phdr) *phdr,
       rtld_timer_accum (&relocate_time, start);
     }
 
+  /* The objects loaded so far can never be unloaded.  Record their
+     number so that dl_iterate_phdr can report them without
+     locking.  */
+  GL(dl_initial_nloaded) = GL(dl_ns)[LM_ID_BASE]._ns_nloaded;
+
   /* Relocation is complete.  Perform early libc initialization.  This
      is the initial libc, even if audit modules have been loaded with
      other libcs.  */
@@ -2436,7 +2400,7 @@ process_dl_debug (struct dl_main_state *state, const char *dl_debug)
   static const struct
   {
     unsigned char len;
-    const char name[10];
+    const char name[16];
     const char helptext[41];
     unsigned short int mask;
   } debopts[] =
@@ -2460,8 +2424,10 @@ process_dl_debug (struct dl_main_state *state, const char *dl_debug)
 	DL_DEBUG_LIBS | DL_DEBUG_RELOC | DL_DEBUG_FILES | DL_DEBUG_SYMBOLS
 	| DL_DEBUG_BINDINGS | DL_DEBUG_VERSIONS | DL_DEBUG_IMPCALLS
 	| DL_DEBUG_SCOPES },
-      { LEN_AND_STR ("statistics"), "display relocation statistics",
-	DL_DEBUG_STATISTICS },
+      { LEN_AND_STR ("statistics"),
+	"display relocation and loading statistics", DL_DEBUG_STATISTICS },
+      { LEN_AND_STR ("profile-startup"),
+	"write per-object startup times as JSON", DL_DEBUG_PROFILE_STARTUP },
       { LEN_AND_STR ("unused"), "determined unused DSOs",
 	DL_DEBUG_UNUSED },
       { LEN_AND_STR ("help"), "display this help message and exit",
@@ -2523,7 +2489,7 @@ Valid options for the LD_DEBUG environment variable are:\n\n");
 
       for (cnt = 0; cnt < ndebopts; ++cnt)
 	_dl_printf ("  %.*s%s%s\n", debopts[cnt].len, debopts[cnt].name,
-		    "         " + debopts[cnt].len - 3,
+		    "                 " + debopts[cnt].len,
 		    debopts[cnt].helptext);
 
       _dl_printf ("\n\
@@ -2791,5 +2757,17 @@ print_statistics (const hp_timing_t *rtld_total_timep)
 #if HP_TIMING_INLINE
   print_statistics_item ("           time needed to load objects",
 			 load_time, *rtld_total_timep);
+  print_statistics_item ("         time needed to search objects",
+			 _dl_load_statistics.search_time, *rtld_total_timep);
+  print_statistics_item ("            time needed to map objects",
+			 _dl_load_statistics.map_time, *rtld_total_timep);
+#endif
+  _dl_debug_printf ("              number of objects mapped: %lu\n"
+		    "      number of files opened in search: %lu\n",
+		    _dl_load_statistics.objects,
+		    _dl_load_statistics.open_attempts);
+#ifdef ELF_MACHINE_IFUNC_CACHE
+  _dl_debug_printf ("  number of cached IFUNC resolutions: %lu\n",
+		    _dl_ifunc_cache_hits);
 #endif
 }
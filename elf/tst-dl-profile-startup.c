@@ -0,0 +1,97 @@
+/* Test LD_DEBUG=profile-startup.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <dlfcn.h>
+#include <getopt.h>
+#include <gnu/lib-names.h>
+#include <hp-timing.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/capture_subprocess.h>
+#include <support/check.h>
+#include <support/support.h>
+
+static int restart;
+#define CMDLINE_OPTIONS \
+  { "restart", no_argument, &restart, 1 },
+
+static int
+do_test (int argc, char *argv[])
+{
+  /* We must have either:
+     - One or four parameters left if called initially:
+       + path to ld.so         optional
+       + "--library-path"      optional
+       + the library path      optional
+       + the application name  */
+  if (restart)
+    {
+      /* The search for an object which is not loaded yet ends without
+	 a link map with RTLD_NOLOAD.  */
+      TEST_VERIFY (dlopen (LIBM_SO, RTLD_NOW | RTLD_NOLOAD) == NULL);
+      return 0;
+    }
+
+  if (!HP_TIMING_INLINE)
+    FAIL_UNSUPPORTED ("no high-precision timer for LD_DEBUG=profile-startup");
+
+  char *spargv[9];
+  int i = 0;
+  for (; i < argc - 1; i++)
+    spargv[i] = argv[i + 1];
+  spargv[i++] = (char *) "--direct";
+  spargv[i++] = (char *) "--restart";
+  spargv[i] = NULL;
+
+  setenv ("LD_DEBUG", "profile-startup", 1);
+  struct support_capture_subprocess result
+    = support_capture_subprogram (spargv[0], spargv);
+  support_capture_subprocess_check (&result, "tst-dl-profile-startup", 0,
+				    sc_allow_stdout);
+
+  /* The profile is a single JSON document, written before main runs.  */
+  const char *out = result.out.buffer;
+  TEST_VERIFY (strncmp (out, "{\n \"timing_type\": \"hp_timing\",\n",
+			strlen ("{\n \"timing_type\": \"hp_timing\",\n")) == 0);
+  TEST_VERIFY (result.out.length >= 3
+	       && strcmp (out + result.out.length - 3, "\n}\n") == 0);
+
+  /* All initial objects are listed, with every phase.  */
+  TEST_VERIFY (strstr (out, LIBC_SO "\",\n   \"namespace\": 0,\n") != NULL);
+  static const char *const phases[] =
+    {
+      "search", "open", "map", "version", "relocate", "irelative", "init"
+    };
+  for (size_t j = 0; j < array_length (phases); ++j)
+    {
+      char *key = xasprintf ("\n   \"%s\": ", phases[j]);
+      TEST_VERIFY (strstr (out, key) != NULL);
+      free (key);
+    }
+
+  /* The totals follow the objects.  */
+  TEST_VERIFY (strstr (out, "\n ],\n \"objects_mapped\": ") != NULL);
+  TEST_VERIFY (strstr (out, ",\n \"files_opened\": ") != NULL);
+
+  support_capture_subprocess_free (&result);
+  return 0;
+}
+
+#define TEST_FUNCTION_ARGV do_test
+#include <support/test-driver.c>
@@ -0,0 +1,130 @@
+/* Test dl_iterate_phdr with concurrent dlopen and dlclose.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <atomic.h>
+#include <dlfcn.h>
+#include <link.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/xdlfcn.h>
+#include <support/xthread.h>
+
+/* The objects loaded at startup, in the order reported by the first
+   call to dl_iterate_phdr.  */
+enum { max_initial = 64 };
+static const ElfW(Phdr) *initial_phdrs[max_initial];
+static size_t initial_count;
+
+static int
+collect_initial (struct dl_phdr_info *info, size_t size, void *closure)
+{
+  TEST_VERIFY_EXIT (initial_count < max_initial);
+  initial_phdrs[initial_count++] = info->dlpi_phdr;
+  return 0;
+}
+
+/* Per-iteration state for check_callback.  */
+struct check_state
+{
+  size_t index;
+  unsigned long long int adds;
+  unsigned long long int subs;
+  bool found_mod;
+};
+
+static const ElfW(Phdr) *mod_phdr;
+
+static int
+check_callback (struct dl_phdr_info *info, size_t size, void *closure)
+{
+  struct check_state *state = closure;
+  TEST_VERIFY (size >= sizeof (*info));
+
+  /* The objects loaded at startup are always reported first, and in
+     the same order.  */
+  if (state->index < initial_count)
+    TEST_VERIFY (info->dlpi_phdr == initial_phdrs[state->index]);
+  else if (info->dlpi_phdr == atomic_load_relaxed (&mod_phdr))
+    state->found_mod = true;
+  ++state->index;
+
+  /* Counters never decrease.  */
+  TEST_VERIFY (info->dlpi_adds >= state->adds);
+  TEST_VERIFY (info->dlpi_subs >= state->subs);
+  TEST_VERIFY (info->dlpi_subs <= info->dlpi_adds);
+  state->adds = info->dlpi_adds;
+  state->subs = info->dlpi_subs;
+  return 0;
+}
+
+static volatile bool stop;
+
+static void *
+iterate_thread (void *ignored)
+{
+  struct check_state state = { 0, };
+  while (!stop)
+    {
+      state.index = 0;
+      dl_iterate_phdr (check_callback, &state);
+      TEST_VERIFY (state.index >= initial_count);
+    }
+  return NULL;
+}
+
+static int
+do_test (void)
+{
+  dl_iterate_phdr (collect_initial, NULL);
+  TEST_VERIFY_EXIT (initial_count > 0);
+
+  enum { thread_count = 4 };
+  pthread_t threads[thread_count];
+  for (int i = 0; i < thread_count; ++i)
+    threads[i] = xpthread_create (NULL, iterate_thread, NULL);
+
+  unsigned long long int last_subs = 0;
+  for (int i = 0; i < 1000; ++i)
+    {
+      void *handle = xdlopen ("tst-dl_find_object-mod1.so", RTLD_NOW);
+      struct link_map *l;
+      TEST_COMPARE (dlinfo (handle, RTLD_DI_LINKMAP, &l), 0);
+
+      /* The newly loaded object must be reported after dlopen has
+         returned.  */
+      struct check_state state = { .adds = 0, };
+      atomic_store_relaxed (&mod_phdr, l->l_phdr);
+      dl_iterate_phdr (check_callback, &state);
+      TEST_VERIFY (state.found_mod);
+      TEST_VERIFY (state.subs >= last_subs);
+      last_subs = state.subs;
+
+      xdlclose (handle);
+    }
+
+  stop = true;
+  for (int i = 0; i < thread_count; ++i)
+    xpthread_join (threads[i]);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
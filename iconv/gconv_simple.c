@@ -620,6 +620,68 @@ ucs4le_internal_loop_single (struct __gconv_step *step,
 #include <iconv/skeleton.c>
 
 
+/* Number of characters checked at once by the ASCII fast paths of the
+   UTF-8 conversions.  The loops over a block have a constant trip count
+   and no early exit, so the compiler can vectorize them.  */
+#define ASCII_BLOCK		16
+
+/* Convert the run of ASCII characters in the internal format at the
+   start of INPTR to UTF-8 at OUTPTR, limited by INEND and OUTEND.
+   Return the number of characters converted.  */
+static inline size_t
+__attribute ((always_inline))
+internal_utf8_ascii (const unsigned char *inptr, const unsigned char *inend,
+		     unsigned char *outptr, const unsigned char *outend)
+{
+  const uint32_t *in = (const uint32_t *) inptr;
+  size_t n = MIN ((size_t) (inend - inptr) / 4, (size_t) (outend - outptr));
+  size_t i = 0;
+
+  for (; i + ASCII_BLOCK <= n; i += ASCII_BLOCK)
+    {
+      uint32_t all = 0;
+      for (size_t j = 0; j < ASCII_BLOCK; ++j)
+	all |= in[i + j];
+      if (all >= 0x80)
+	break;
+      for (size_t j = 0; j < ASCII_BLOCK; ++j)
+	outptr[i + j] = in[i + j];
+    }
+  for (; i < n && in[i] < 0x80; ++i)
+    outptr[i] = in[i];
+
+  return i;
+}
+
+/* Convert the run of ASCII characters at the start of INPTR to the
+   internal format at OUTPTR, limited by INEND and OUTEND.  Return the
+   number of characters converted.  */
+static inline size_t
+__attribute ((always_inline))
+utf8_internal_ascii (const unsigned char *inptr, const unsigned char *inend,
+		     unsigned char *outptr, const unsigned char *outend)
+{
+  uint32_t *out = (uint32_t *) outptr;
+  size_t n = MIN ((size_t) (inend - inptr), (size_t) (outend - outptr) / 4);
+  size_t i = 0;
+
+  for (; i + ASCII_BLOCK <= n; i += ASCII_BLOCK)
+    {
+      unsigned char all = 0;
+      for (size_t j = 0; j < ASCII_BLOCK; ++j)
+	all |= inptr[i + j];
+      if (all >= 0x80)
+	break;
+      for (size_t j = 0; j < ASCII_BLOCK; ++j)
+	out[i + j] = inptr[i + j];
+    }
+  for (; i < n && inptr[i] < 0x80; ++i)
+    out[i] = inptr[i];
+
+  return i;
+}
+
+
 /* Convert from the internal (UCS4-like) format to UTF-8.  */
 #define DEFINE_INIT		0
 #define DEFINE_FINI		0
@@ -641,8 +703,14 @@ ucs4le_internal_loop_single (struct __gconv_step *step,
     uint32_t wc = *((const uint32_t *) inptr);				      \
 									      \
     if (__glibc_likely (wc < 0x80))					      \
-      /* It's an one byte sequence.  */					      \
-      *outptr++ = (unsigned char) wc;					      \
+      {									      \
+	/* It's an one byte sequence.  Convert all the following ASCII	      \
+	   characters at once.  */					      \
+	size_t n = internal_utf8_ascii (inptr, inend, outptr, outend);	      \
+	inptr += 4 * n;							      \
+	outptr += n;							      \
+	continue;							      \
+      }									      \
     else if (__glibc_likely (wc <= 0x7fffffff				      \
 			     && (wc < 0xd800 || wc > 0xdfff)))		      \
       {									      \
@@ -706,8 +774,12 @@ ucs4le_internal_loop_single (struct __gconv_step *step,
 									      \
     if (__glibc_likely (ch < 0x80))					      \
       {									      \
-	/* One byte sequence.  */					      \
-	++inptr;							      \
+	/* One byte sequence.  Convert all the following ASCII		      \
+	   characters at once.  */					      \
+	size_t n = utf8_internal_ascii (inptr, inend, outptr, outend);	      \
+	inptr += n;							      \
+	outptr += 4 * n;						      \
+	continue;							      \
       }									      \
     else								      \
       {									      \
@@ -32,6 +32,11 @@ extern int __open64_2 (const char *__path, int __oflag);
 extern int __openat_2 (int __fd, const char *__path, int __oflag);
 extern int __openat64_2 (int __fd, const char *__path, int __oflag);
 
+/* Like posix_fadvise64, used by stdio for readahead hints.  */
+extern int __posix_fadvise64_l64 (int __fd, __off64_t __offset,
+				  __off64_t __len, int __advise);
+libc_hidden_proto (__posix_fadvise64_l64)
+
 
 #if IS_IN (rtld)
 #  include <dl-fcntl.h>
@@ -347,6 +347,9 @@ struct link_map
     size_t l_relro_size;
 
     unsigned long long int l_serial;
+
+    /* Timings collected for LD_DEBUG=profile-startup, or NULL.  */
+    struct dl_startup_profile *l_startup_profile;
   };
 
 #include <dl-relocate-ld.h>
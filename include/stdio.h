@@ -197,6 +197,27 @@ int __vfxprintf (FILE *__fp, const char *__fmt, __gnuc_va_list,
 		 unsigned int)
   attribute_hidden;
 
+/* Per-thread cache of parsed printf formats, see
+   stdio-common/printf-spec-cache.c.  */
+struct printf_spec_cache;
+/* Release CACHE, on thread exit.  */
+extern void __printf_spec_cache_free (struct printf_spec_cache *cache)
+     attribute_hidden;
+
+/* Per-thread output buffers of the standard streams, see
+   libio/threadbuf.c.  */
+struct _IO_thread_buffer;
+/* Switch the streams selected by the glibc.stdio.thread_buffering
+   tunable to per-thread buffering, at startup.  */
+extern void _IO_thread_buffering_init (void) attribute_hidden;
+/* Write out and release the buffers in LIST, on thread exit.  */
+extern void _IO_thread_buffers_free (struct _IO_thread_buffer *list)
+     attribute_hidden;
+
+/* Enable the collection of stream statistics if requested by the
+   glibc.stdio.stream_stats tunable, at startup.  */
+extern void _IO_stats_init (void) attribute_hidden;
+
 extern const char *const _sys_errlist_internal[] attribute_hidden;
 extern const size_t _sys_errlist_internal_len attribute_hidden;
 extern const char *__get_errlist (int) attribute_hidden;
@@ -147,8 +147,6 @@ extern int __posix_openpt (int __oflag) attribute_hidden;
 extern int __add_to_environ (const char *name, const char *value,
 			     const char *combines, int replace)
      attribute_hidden;
-extern void _quicksort (void *const pbase, size_t total_elems,
-			size_t size, __compar_d_fn_t cmp, void *arg);
 
 extern int __on_exit (void (*__func) (int __status, void *__arg), void *__arg);
 
@@ -192,6 +190,13 @@ __typeof (arc4random_uniform) __arc4random_uniform;
 libc_hidden_proto (__arc4random_uniform);
 extern void __arc4random_buf_internal (void *buffer, size_t len)
      attribute_hidden;
+/* Per-thread state of arc4random, see stdlib/arc4random.c.  */
+struct arc4random_state_t;
+/* Clear the state of the calling thread in the child after fork.  */
+extern void __arc4random_fork_subprocess (void) attribute_hidden;
+/* Release STATE, on thread exit.  */
+extern void __arc4random_state_free (struct arc4random_state_t *state)
+     attribute_hidden;
 
 extern double __strtod_internal (const char *__restrict __nptr,
 				 char **__restrict __endptr, int __group)
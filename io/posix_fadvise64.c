@@ -22,8 +22,10 @@
    respect to the file associated with FD.  */
 
 int
-posix_fadvise64 (int fd, __off64_t offset, __off64_t len, int advise)
+__posix_fadvise64_l64 (int fd, __off64_t offset, __off64_t len, int advise)
 {
   return ENOSYS;
 }
+libc_hidden_def (__posix_fadvise64_l64)
+weak_alias (__posix_fadvise64_l64, posix_fadvise64)
 stub_warning (posix_fadvise64)
@@ -0,0 +1,97 @@
+/* Per-stream I/O statistics.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The size of FILE is part of the ABI, so the statistics of a stream
+   are kept in a separate structure, allocated when the stream first
+   issues a system call or allocates its buffer.  The __pad5 member of
+   FILE, which is otherwise unused, points to it.  It is released when
+   the stream is closed.  Nothing is allocated unless the
+   glibc.stdio.stream_stats tunable is set, and the cost for streams
+   without statistics is a test of _IO_stats_enabled.
+
+   The counters are updated by the system call wrappers of the file
+   jump table in fileops.c, with the stream locked.  Output written by
+   the per-thread buffers of threadbuf.c and data copied by fcopy
+   within the kernel are not accounted for.  */
+
+#include "libioP.h"
+#include <errno.h>
+#include <stdio_ext.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TUNABLE_NAMESPACE stdio
+#include <elf/dl-tunables.h>
+
+bool _IO_stats_enabled;
+
+void
+_IO_stats_init (void)
+{
+  _IO_stats_enabled = TUNABLE_GET (stream_stats, int32_t, NULL) != 0;
+}
+
+struct __stdio_stats *
+_IO_stats_alloc (FILE *fp)
+{
+  /* This is called before the system call being accounted for, which
+     sets errno itself if it fails.  */
+  int save_errno = errno;
+  struct __stdio_stats *stats = calloc (1, sizeof (*stats));
+  __set_errno (save_errno);
+  fp->__pad5 = (size_t) stats;
+  return stats;
+}
+
+void
+_IO_stats_free (FILE *fp)
+{
+  if (_IO_vtable_offset (fp) == 0 && fp->__pad5 != 0)
+    {
+      free ((void *) fp->__pad5);
+      fp->__pad5 = 0;
+    }
+}
+
+uint64_t
+_IO_stats_clock (void)
+{
+  struct __timespec64 ts;
+  __clock_gettime64 (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * (uint64_t) 1000000000 + ts.tv_nsec;
+}
+
+int
+__fstats (FILE *fp, struct __stdio_stats *stats)
+{
+  if (!_IO_stats_enabled || _IO_vtable_offset (fp) != 0)
+    {
+      __set_errno (ENOTSUP);
+      return -1;
+    }
+
+  _IO_flockfile (fp);
+  if (fp->__pad5 != 0)
+    *stats = *(struct __stdio_stats *) fp->__pad5;
+  else
+    /* The stream has not done any I/O yet.  */
+    memset (stats, 0, sizeof (*stats));
+  _IO_funlockfile (fp);
+  return 0;
+}
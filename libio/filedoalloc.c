@@ -57,10 +57,15 @@
 
 #include "libioP.h"
 #include <device-nrs.h>
+#include <fcntl.h>
+#include <stdio_ext.h>
 #include <sys/stat.h>
 #include <stdlib.h>
 #include <unistd.h>
 
+#define TUNABLE_NAMESPACE stdio
+#include <elf/dl-tunables.h>
+
 /* Return the result of isatty, without changing errno.  */
 static int
 local_isatty (int fd)
@@ -72,7 +77,8 @@ local_isatty (int fd)
 }
 
 /* Allocate a file buffer, or switch to unbuffered I/O.  Streams for
-   TTY devices default to line buffered.  */
+   TTY devices default to line buffered.  The glibc.stdio.buffer_size
+   tunable overrides the size derived from st_blksize.  */
 int
 _IO_file_doallocate (FILE *fp)
 {
@@ -98,10 +104,47 @@ _IO_file_doallocate (FILE *fp)
 	size = st.st_blksize;
 #endif
     }
+  size_t tunable_size = TUNABLE_GET (buffer_size, size_t, NULL);
+  if (tunable_size != 0)
+    size = tunable_size;
   p = malloc (size);
   if (__glibc_unlikely (p == NULL))
     return EOF;
   _IO_setb (fp, p, p + size, 1);
+  struct __stdio_stats *stats = _IO_stats (fp);
+  if (stats != NULL)
+    ++stats->buffer_allocations;
   return 1;
 }
 libc_hidden_def (_IO_file_doallocate)
+
+/* Replace the buffer of FP, which must be empty, by one twice its
+   size, up to the glibc.stdio.max_buffer_size tunable, and tell the
+   kernel that the file is read sequentially.  Return false if the
+   buffer is already at the limit or cannot be allocated, in which case
+   the old buffer is kept.  */
+bool
+_IO_file_grow_buffer (FILE *fp)
+{
+  size_t size = _IO_blen (fp);
+  size_t max_size = TUNABLE_GET (max_buffer_size, size_t, NULL);
+  if (size >= max_size)
+    return false;
+
+  size_t new_size = size <= max_size / 2 ? 2 * size : max_size;
+  char *p = malloc (new_size);
+  if (p == NULL)
+    return false;
+
+  /* Ask for a larger readahead window.  This is only a hint, so
+     failures are ignored.  The call does not change errno.  */
+  __posix_fadvise64_l64 (fp->_fileno, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  _IO_setb (fp, p, p + new_size, 1);
+  _IO_setg (fp, p, p, p);
+  _IO_setp (fp, p, p);
+  struct __stdio_stats *stats = _IO_stats (fp);
+  if (stats != NULL)
+    ++stats->buffer_allocations;
+  return true;
+}
@@ -28,14 +28,17 @@
 #include "libioP.h"
 #include <assert.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <string.h>
 #include <errno.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <stdio_ext.h>
 #include "../wcsmbs/wcsmbsload.h"
 #include "../iconv/gconv_charset.h"
 #include "../iconv/gconv_int.h"
@@ -43,6 +46,9 @@
 #include <not-cancel.h>
 #include <kernel-features.h>
 
+#define TUNABLE_NAMESPACE stdio
+#include <elf/dl-tunables.h>
+
 extern struct __gconv_trans_data __libio_translit attribute_hidden;
 
 /* An fstream can be in at most one of put mode, get mode, or putback mode.
@@ -135,6 +141,12 @@ _IO_new_file_close_it (FILE *fp)
     write_status = _IO_do_flush (fp);
   else
     write_status = 0;
+  if ((fp->_flags2 & _IO_FLAGS2_THREAD_BUFFERED) != 0)
+    {
+      if (_IO_thread_buffer_flush (fp) == EOF)
+	write_status = EOF;
+      fp->_flags2 &= ~_IO_FLAGS2_THREAD_BUFFERED;
+    }
 
   _IO_unsave_markers (fp);
 
@@ -158,6 +170,7 @@ _IO_new_file_close_it (FILE *fp)
   fp->_flags = _IO_MAGIC|CLOSED_FILEBUF_FLAGS;
   fp->_fileno = -1;
   fp->_offset = _IO_pos_BAD;
+  _IO_stats_free (fp);
 
   return close_status ? close_status : write_status;
 }
@@ -447,6 +460,15 @@ new_do_write (FILE *fp, const char *data, size_t to_do)
       fp->_offset = new_pos;
     }
   count = _IO_SYSWRITE (fp, data, to_do);
+  if (data == fp->_IO_write_base)
+    {
+      struct __stdio_stats *stats = _IO_stats (fp);
+      if (stats != NULL)
+	{
+	  ++stats->flushes;
+	  stats->bytes_written_buffered += count;
+	}
+    }
   if (fp->_cur_column && count)
     fp->_cur_column = _IO_adjust_column (fp->_cur_column - 1, data, count) + 1;
   _IO_setg (fp, fp->_IO_buf_base, fp->_IO_buf_base, fp->_IO_buf_base);
@@ -457,6 +479,91 @@ new_do_write (FILE *fp, const char *data, size_t to_do)
   return count;
 }
 
+/* Write the pending contents of the buffer of FP followed by TO_DO
+   bytes from DATA with a single writev, then mark FP as having empty
+   buffers.  This is new_do_write for the buffer and DATA at once.
+   Return the number of bytes of DATA which have been written, which is
+   less than TO_DO on error.  */
+
+static size_t
+new_do_writev (FILE *fp, const char *data, size_t to_do)
+{
+  size_t pending = fp->_IO_write_ptr - fp->_IO_write_base;
+  struct iovec iov[2] =
+    {
+      { .iov_base = fp->_IO_write_base, .iov_len = pending },
+      { .iov_base = (void *) data, .iov_len = to_do }
+    };
+  struct iovec *iovp = iov;
+  int iovcnt = 2;
+  size_t written = 0;
+
+  if (fp->_flags & _IO_IS_APPENDING)
+    fp->_offset = _IO_pos_BAD;
+  else if (fp->_IO_read_end != fp->_IO_write_base)
+    {
+      off64_t new_pos
+	= _IO_SYSSEEK (fp, fp->_IO_write_base - fp->_IO_read_end, 1);
+      if (new_pos == _IO_pos_BAD)
+	return 0;
+      fp->_offset = new_pos;
+    }
+
+  struct __stdio_stats *stats = _IO_stats (fp);
+  uint64_t start = stats != NULL ? _IO_stats_clock () : 0;
+
+  /* Retry short writes like _IO_new_file_write does.  */
+  while (iovcnt > 0)
+    {
+      ssize_t count = __writev (fp->_fileno, iovp, iovcnt);
+      if (stats != NULL)
+	++stats->write_calls;
+      if (count < 0)
+	{
+	  fp->_flags |= _IO_ERR_SEEN;
+	  break;
+	}
+      written += count;
+      while (iovcnt > 0 && (size_t) count >= iovp->iov_len)
+	{
+	  count -= iovp->iov_len;
+	  ++iovp;
+	  --iovcnt;
+	}
+      if (iovcnt > 0)
+	{
+	  iovp->iov_base = (char *) iovp->iov_base + count;
+	  iovp->iov_len -= count;
+	}
+    }
+  if (fp->_offset >= 0)
+    fp->_offset += written;
+  if (stats != NULL)
+    {
+      if (pending > 0)
+	++stats->flushes;
+      stats->bytes_written += written;
+      stats->bytes_written_buffered += MIN (written, pending);
+      stats->blocked_ns += _IO_stats_clock () - start;
+    }
+
+  if (fp->_cur_column && written)
+    {
+      size_t count = MIN (written, pending);
+      fp->_cur_column = _IO_adjust_column (fp->_cur_column - 1,
+					   fp->_IO_write_base, count) + 1;
+      if (written > pending)
+	fp->_cur_column = _IO_adjust_column (fp->_cur_column - 1, data,
+					     written - pending) + 1;
+    }
+  _IO_setg (fp, fp->_IO_buf_base, fp->_IO_buf_base, fp->_IO_buf_base);
+  fp->_IO_write_base = fp->_IO_write_ptr = fp->_IO_buf_base;
+  fp->_IO_write_end = (fp->_mode <= 0
+		       && (fp->_flags & (_IO_LINE_BUF | _IO_UNBUFFERED))
+		       ? fp->_IO_buf_base : fp->_IO_buf_end);
+  return written > pending ? written - pending : 0;
+}
+
 int
 _IO_new_file_underflow (FILE *fp)
 {
@@ -503,6 +610,23 @@ _IO_new_file_underflow (FILE *fp)
       _IO_release_lock (stdout);
     }
 
+  /* If the previous refill filled the whole buffer and it has been
+     consumed, the file is probably being read sequentially.  After the
+     second such refill in a row, double the buffer to cut down on the
+     number of read calls.  Buffers supplied by the user are never
+     replaced.  */
+  if (fp->_IO_read_base == fp->_IO_buf_base
+      && fp->_IO_read_end == fp->_IO_buf_end
+      && (fp->_flags & (_IO_LINE_BUF | _IO_UNBUFFERED | _IO_USER_BUF
+			| _IO_CURRENTLY_PUTTING)) == 0)
+    {
+      if (fp->_flags2 & _IO_FLAGS2_READ_SEQUENTIAL)
+	_IO_file_grow_buffer (fp);
+      fp->_flags2 |= _IO_FLAGS2_READ_SEQUENTIAL;
+    }
+  else
+    fp->_flags2 &= ~_IO_FLAGS2_READ_SEQUENTIAL;
+
   _IO_switch_to_get_mode (fp);
 
   /* This is very tricky. We have to adjust those
@@ -523,6 +647,9 @@ _IO_new_file_underflow (FILE *fp)
       else
 	fp->_flags |= _IO_ERR_SEEN, count = 0;
   }
+  struct __stdio_stats *stats = _IO_stats (fp);
+  if (stats != NULL)
+    stats->bytes_read_buffered += count;
   fp->_IO_read_end += count;
   if (count == 0)
     {
@@ -538,6 +665,93 @@ _IO_new_file_underflow (FILE *fp)
 }
 libc_hidden_ver (_IO_new_file_underflow, _IO_file_underflow)
 
+/* Size of the mapping used for a stream in windowed mmap mode, or zero
+   if streams map the whole file.  It is a multiple of the page size and
+   at least two pages, so that a window can always be moved forward to
+   the page holding the current position.  */
+static size_t
+mmap_window_size (void)
+{
+  size_t size = TUNABLE_GET (mmap_window_size, size_t, NULL);
+  if (size == 0)
+    return 0;
+  const size_t pagesize = __getpagesize ();
+  return MAX (size & ~(pagesize - 1), 2 * pagesize);
+}
+
+/* In windowed mmap mode the file offset of _IO_buf_base, in pages, is
+   kept in _old_offset, which is otherwise only used by the streams of
+   oldfileops.c.  */
+static inline off64_t
+mmap_window_start (FILE *fp)
+{
+  if ((fp->_flags2 & _IO_FLAGS2_MMAP_WINDOW) == 0)
+    return 0;
+  return (off64_t) fp->_old_offset * __getpagesize ();
+}
+
+/* Set up the window of FP so that it contains the file position POS and
+   point the get area at it.  The current mapping is kept if it covers
+   POS, unless MOVE is true, in which case the window always starts at
+   the page holding POS.  As with the whole file mapping, _offset and
+   the descriptor are positioned at the end of the mapped data, or at
+   POS if that is past the end of the file.  Return zero on success.
+   On failure the stream is left unchanged.  */
+static int
+mmap_window_map (FILE *fp, off64_t pos, bool move)
+{
+  struct __stat64_t64 st;
+
+  if (_IO_SYSSTAT (fp, &st) != 0 || !S_ISREG (st.st_mode)
+      || st.st_size == 0)
+    return 1;
+
+  const size_t pagesize = __getpagesize ();
+  const size_t window = mmap_window_size ();
+  /* Past the end of the file, map its last page so that the window is
+     never empty.  */
+  off64_t data_pos = MIN (pos, st.st_size - 1);
+  off64_t start = mmap_window_start (fp);
+  char *base = fp->_IO_buf_base;
+
+  if (base == NULL || move || data_pos < start
+      || data_pos - start >= window)
+    {
+      start = data_pos & ~((off64_t) pagesize - 1);
+      if ((__off_t) (start / pagesize) != start / pagesize)
+	return 1;
+
+      int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+      /* Read the whole window in with the mmap call instead of faulting
+	 it in page by page.  */
+      flags |= MAP_POPULATE;
+#endif
+      void *p = __mmap64 (NULL, window, PROT_READ, flags, fp->_fileno,
+			  start);
+      if (p == MAP_FAILED)
+	return 1;
+      (void) __madvise (p, window, MADV_SEQUENTIAL);
+      if (base != NULL)
+	(void) __munmap (base, window);
+      base = p;
+      fp->_old_offset = start / pagesize;
+    }
+
+  size_t len = MIN ((off64_t) window, st.st_size - start);
+  off64_t new_offset = pos <= start + len ? start + len : pos;
+  _IO_setb (fp, base, base + len, 0);
+  _IO_setg (fp, base, base + MIN (pos - start, (off64_t) len), base + len);
+
+  if (new_offset != fp->_offset)
+    {
+      if (__lseek64 (fp->_fileno, new_offset, SEEK_SET) != new_offset)
+	fp->_flags |= _IO_ERR_SEEN;
+      fp->_offset = new_offset;
+    }
+  return 0;
+}
+
 /* Guts of underflow callback if we mmap the file.  This stats the file and
    updates the stream state to match.  In the normal case we return zero.
    If the file is no longer eligible for mmap, its jump tables are reset to
@@ -547,6 +761,22 @@ mmap_remap_check (FILE *fp)
 {
   struct __stat64_t64 st;
 
+  if (fp->_flags2 & _IO_FLAGS2_MMAP_WINDOW)
+    {
+      /* Map the next window if the current one has been consumed, or
+	 pick up data appended to the file.  */
+      off64_t pos = fp->_offset - (fp->_IO_read_end - fp->_IO_read_ptr);
+      if (mmap_window_map (fp, pos, false) == 0)
+	return 0;
+
+      /* Continue with the vanilla functions at the current position.  */
+      (void) __munmap (fp->_IO_buf_base, mmap_window_size ());
+      if (__lseek64 (fp->_fileno, pos, SEEK_SET) != pos)
+	fp->_flags |= _IO_ERR_SEEN;
+      fp->_offset = pos;
+      goto punt;
+    }
+
   if (_IO_SYSSTAT (fp, &st) == 0
       && S_ISREG (st.st_mode) && st.st_size != 0
       /* Limit the file size to 1MB for 32-bit machines.  */
@@ -625,6 +855,7 @@ mmap_remap_check (FILE *fp)
       (void) __munmap (fp->_IO_buf_base,
 		       fp->_IO_buf_end - fp->_IO_buf_base);
     punt:
+      fp->_flags2 &= ~_IO_FLAGS2_MMAP_WINDOW;
       fp->_IO_buf_base = fp->_IO_buf_end = NULL;
       _IO_setg (fp, NULL, NULL, NULL);
       if (fp->_mode <= 0)
@@ -637,6 +868,20 @@ mmap_remap_check (FILE *fp)
     }
 }
 
+/* Move the window of FP in windowed mmap mode so that it starts at the
+   page holding the current position.  This is used when the data left
+   in the window is too short to be converted, such as a multibyte
+   character straddling the end of the window.  Return nonzero if the
+   stream has been switched to the vanilla functions instead.  */
+int
+_IO_file_mmap_window_move (FILE *fp)
+{
+  off64_t pos = fp->_offset - (fp->_IO_read_end - fp->_IO_read_ptr);
+  if (mmap_window_map (fp, pos, true) == 0)
+    return 0;
+  return mmap_remap_check (fp);
+}
+
 /* Special callback replacing the underflow callbacks if we mmap the file.  */
 int
 _IO_file_underflow_mmap (FILE *fp)
@@ -665,12 +910,29 @@ decide_maybe_mmap (FILE *fp)
      this would require too much virtual memory.  */
   struct __stat64_t64 st;
 
-  if (_IO_SYSSTAT (fp, &st) == 0
-      && S_ISREG (st.st_mode) && st.st_size != 0
-      /* Limit the file size to 1MB for 32-bit machines.  */
-      && (sizeof (ptrdiff_t) > 4 || st.st_size < 1*1024*1024)
-      /* Sanity check.  */
-      && (fp->_offset == _IO_pos_BAD || fp->_offset <= st.st_size))
+  if (mmap_window_size () != 0)
+    {
+      /* Map the file a window at a time.  This works for files of any
+	 size, also on 32-bit machines.  */
+      fp->_flags2 |= _IO_FLAGS2_MMAP_WINDOW;
+      if (mmap_window_map (fp, fp->_offset == _IO_pos_BAD ? 0 : fp->_offset,
+			   false) == 0)
+	{
+	  if (fp->_mode <= 0)
+	    _IO_JUMPS_FILE_plus (fp) = &_IO_file_jumps_mmap;
+	  else
+	    _IO_JUMPS_FILE_plus (fp) = &_IO_wfile_jumps_mmap;
+	  fp->_wide_data->_wide_vtable = &_IO_wfile_jumps_mmap;
+	  return;
+	}
+      fp->_flags2 &= ~_IO_FLAGS2_MMAP_WINDOW;
+    }
+  else if (_IO_SYSSTAT (fp, &st) == 0
+	   && S_ISREG (st.st_mode) && st.st_size != 0
+	   /* Limit the file size to 1MB for 32-bit machines.  */
+	   && (sizeof (ptrdiff_t) > 4 || st.st_size < 1*1024*1024)
+	   /* Sanity check.  */
+	   && (fp->_offset == _IO_pos_BAD || fp->_offset <= st.st_size))
     {
       /* Try to map the file.  */
       void *p;
@@ -736,6 +998,8 @@ _IO_new_file_overflow (FILE *f, int ch)
       __set_errno (EBADF);
       return EOF;
     }
+  if (__glibc_unlikely (f->_flags2 & _IO_FLAGS2_THREAD_BUFFERED))
+    return _IO_thread_buffer_overflow (f, ch);
   /* If currently reading or no buffer allocated. */
   if ((f->_flags & _IO_CURRENTLY_PUTTING) == 0 || f->_IO_write_base == NULL)
     {
@@ -794,6 +1058,9 @@ _IO_new_file_sync (FILE *fp)
   ssize_t delta;
   int retval = 0;
 
+  if (__glibc_unlikely (fp->_flags2 & _IO_FLAGS2_THREAD_BUFFERED)
+      && _IO_thread_buffer_flush (fp) == EOF)
+    return EOF;
   /*    char* ptr = cur_ptr(); */
   if (fp->_IO_write_ptr > fp->_IO_write_base)
     if (_IO_do_flush(fp)) return EOF;
@@ -819,17 +1086,16 @@ libc_hidden_ver (_IO_new_file_sync, _IO_file_sync)
 int
 _IO_file_sync_mmap (FILE *fp)
 {
+  off64_t pos = fp->_offset - (fp->_IO_read_end - fp->_IO_read_ptr);
   if (fp->_IO_read_ptr != fp->_IO_read_end)
     {
-      if (__lseek64 (fp->_fileno, fp->_IO_read_ptr - fp->_IO_buf_base,
-		     SEEK_SET)
-	  != fp->_IO_read_ptr - fp->_IO_buf_base)
+      if (__lseek64 (fp->_fileno, pos, SEEK_SET) != pos)
 	{
 	  fp->_flags |= _IO_ERR_SEEN;
 	  return EOF;
 	}
     }
-  fp->_offset = fp->_IO_read_ptr - fp->_IO_buf_base;
+  fp->_offset = pos;
   fp->_IO_read_end = fp->_IO_read_ptr = fp->_IO_read_base;
   return 0;
 }
@@ -903,12 +1169,20 @@ _IO_new_file_seekoff (FILE *fp, off64_t offset, int dir, int mode)
   off64_t delta, new_offset;
   long count;
 
+  /* The position includes the output of the calling thread.  */
+  if (__glibc_unlikely (fp->_flags2 & _IO_FLAGS2_THREAD_BUFFERED)
+      && _IO_thread_buffer_flush (fp) == EOF)
+    return EOF;
+
   /* Short-circuit into a separate function.  We don't want to mix any
      functionality and we don't want to touch anything inside the FILE
      object. */
   if (mode == 0)
     return do_ftell (fp);
 
+  /* A seek ends any sequential run; see _IO_new_file_underflow.  */
+  fp->_flags2 &= ~_IO_FLAGS2_READ_SEQUENTIAL;
+
   /* POSIX.1 8.2.3.7 says that after a call the fflush() the file
      offset of the underlying file must be exact.  */
   int must_be_exact = (fp->_IO_read_base == fp->_IO_read_end
@@ -1016,6 +1290,9 @@ _IO_new_file_seekoff (FILE *fp, off64_t offset, int dir, int mode)
       count = _IO_SYSREAD (fp, fp->_IO_buf_base,
 			   (must_be_exact
 			    ? delta : fp->_IO_buf_end - fp->_IO_buf_base));
+      struct __stdio_stats *stats = _IO_stats (fp);
+      if (stats != NULL && count > 0)
+	stats->bytes_read_buffered += count;
       if (count < delta)
 	{
 	  /* We weren't allowed to read, but try to seek the remainder. */
@@ -1070,13 +1347,23 @@ _IO_file_seekoff_mmap (FILE *fp, off64_t offset, int dir, int mode)
   switch (dir)
     {
     case _IO_seek_cur:
-      /* Adjust for read-ahead (bytes is buffer). */
-      offset += fp->_IO_read_ptr - fp->_IO_read_base;
+      /* Adjust for read-ahead (bytes is buffer).  After a sync or a seek
+	 past the end, the read pointers do not reflect the position.  */
+      offset += fp->_offset - (fp->_IO_read_end - fp->_IO_read_ptr);
       break;
     case _IO_seek_set:
       break;
     case _IO_seek_end:
-      offset += fp->_IO_buf_end - fp->_IO_buf_base;
+      if (fp->_flags2 & _IO_FLAGS2_MMAP_WINDOW)
+	{
+	  /* The window does not extend to the end of the file.  */
+	  struct __stat64_t64 st;
+	  if (_IO_SYSSTAT (fp, &st) != 0)
+	    return EOF;
+	  offset += st.st_size;
+	}
+      else
+	offset += fp->_IO_buf_end - fp->_IO_buf_base;
       break;
     }
   /* At this point, dir==_IO_seek_set. */
@@ -1092,6 +1379,19 @@ _IO_file_seekoff_mmap (FILE *fp, off64_t offset, int dir, int mode)
   if (result < 0)
     return EOF;
 
+  if (fp->_flags2 & _IO_FLAGS2_MMAP_WINDOW)
+    {
+      /* Map the window holding the new position right away, which
+	 leaves the read pointers at the position.  */
+      fp->_offset = result;
+      _IO_setg (fp, fp->_IO_buf_base, fp->_IO_buf_end, fp->_IO_buf_end);
+      if (__glibc_unlikely (mmap_remap_check (fp)))
+	/* We punted to the regular file functions.  */
+	return _IO_SEEKOFF (fp, offset, _IO_seek_set, mode);
+      _IO_mask_flags (fp, 0, _IO_EOF_SEEN);
+      return offset;
+    }
+
   if (offset > fp->_IO_buf_end - fp->_IO_buf_base)
     /* One can fseek arbitrarily past the end of the file
        and it is meaningless until one attempts to read.
@@ -1129,16 +1429,34 @@ _IO_file_seekoff_maybe_mmap (FILE *fp, off64_t offset, int dir,
 ssize_t
 _IO_file_read (FILE *fp, void *buf, ssize_t size)
 {
-  return (__builtin_expect (fp->_flags2 & _IO_FLAGS2_NOTCANCEL, 0)
-	  ? __read_nocancel (fp->_fileno, buf, size)
-	  : __read (fp->_fileno, buf, size));
+  struct __stdio_stats *stats = _IO_stats (fp);
+  uint64_t start = stats != NULL ? _IO_stats_clock () : 0;
+  ssize_t count = (__builtin_expect (fp->_flags2 & _IO_FLAGS2_NOTCANCEL, 0)
+		   ? __read_nocancel (fp->_fileno, buf, size)
+		   : __read (fp->_fileno, buf, size));
+  if (stats != NULL)
+    {
+      ++stats->read_calls;
+      if (count > 0)
+	stats->bytes_read += count;
+      stats->blocked_ns += _IO_stats_clock () - start;
+    }
+  return count;
 }
 libc_hidden_def (_IO_file_read)
 
 off64_t
 _IO_file_seek (FILE *fp, off64_t offset, int dir)
 {
-  return __lseek64 (fp->_fileno, offset, dir);
+  struct __stdio_stats *stats = _IO_stats (fp);
+  uint64_t start = stats != NULL ? _IO_stats_clock () : 0;
+  off64_t result = __lseek64 (fp->_fileno, offset, dir);
+  if (stats != NULL)
+    {
+      ++stats->seek_calls;
+      stats->blocked_ns += _IO_stats_clock () - start;
+    }
+  return result;
 }
 libc_hidden_def (_IO_file_seek)
 
@@ -1153,7 +1471,10 @@ int
 _IO_file_close_mmap (FILE *fp)
 {
   /* In addition to closing the file descriptor we have to unmap the file.  */
-  (void) __munmap (fp->_IO_buf_base, fp->_IO_buf_end - fp->_IO_buf_base);
+  (void) __munmap (fp->_IO_buf_base,
+		   (fp->_flags2 & _IO_FLAGS2_MMAP_WINDOW
+		    ? mmap_window_size ()
+		    : fp->_IO_buf_end - fp->_IO_buf_base));
   fp->_IO_buf_base = fp->_IO_buf_end = NULL;
   /* Cancelling close should be avoided if possible since it leaves an
      unrecoverable state behind.  */
@@ -1173,12 +1494,16 @@ ssize_t
 _IO_new_file_write (FILE *f, const void *data, ssize_t n)
 {
   ssize_t to_do = n;
+  struct __stdio_stats *stats = _IO_stats (f);
+  uint64_t start = stats != NULL ? _IO_stats_clock () : 0;
   while (to_do > 0)
     {
       ssize_t count = (__builtin_expect (f->_flags2
                                          & _IO_FLAGS2_NOTCANCEL, 0)
 			   ? __write_nocancel (f->_fileno, data, to_do)
 			   : __write (f->_fileno, data, to_do));
+      if (stats != NULL)
+	++stats->write_calls;
       if (count < 0)
 	{
 	  f->_flags |= _IO_ERR_SEEN;
@@ -1190,6 +1515,11 @@ _IO_new_file_write (FILE *f, const void *data, ssize_t n)
   n -= to_do;
   if (f->_offset >= 0)
     f->_offset += n;
+  if (stats != NULL)
+    {
+      stats->bytes_written += n;
+      stats->blocked_ns += _IO_stats_clock () - start;
+    }
   return n;
 }
 
@@ -1203,6 +1533,8 @@ _IO_new_file_xsputn (FILE *f, const void *data, size_t n)
 
   if (n <= 0)
     return 0;
+  if (__glibc_unlikely (f->_flags2 & _IO_FLAGS2_THREAD_BUFFERED))
+    return _IO_thread_buffer_xsputn (f, data, n);
   /* This is an optimized implementation.
      If the amount to be written straddles a block boundary
      (or the filebuf is unbuffered), use sys_write directly. */
@@ -1240,23 +1572,45 @@ _IO_new_file_xsputn (FILE *f, const void *data, size_t n)
   if (to_do + must_flush > 0)
     {
       size_t block_size, do_write;
-      /* Next flush the (full) buffer. */
-      if (_IO_OVERFLOW (f, EOF) == EOF)
-	/* If nothing else has to be written we must not signal the
-	   caller that everything has been written.  */
-	return to_do == 0 ? EOF : n - to_do;
 
-      /* Try to maintain alignment: write a whole number of blocks.  */
+      /* If both the buffer and the data have to be written, submit
+	 them with a single system call.  This is only done for plain
+	 files in write mode, where flushing the buffer is the same as
+	 new_do_write.  The buffer is allocated since it is not empty.  */
       block_size = f->_IO_buf_end - f->_IO_buf_base;
       do_write = to_do - (block_size >= 128 ? to_do % block_size : 0);
-
-      if (do_write)
+      if (do_write > 0
+	  && f->_IO_write_ptr > f->_IO_write_base
+	  && (f->_flags & _IO_CURRENTLY_PUTTING)
+	  && (f->_flags2 & _IO_FLAGS2_NOTCANCEL) == 0
+	  && _IO_JUMPS_FILE_plus (f) == &_IO_file_jumps
+	  && do_write <= SSIZE_MAX - (f->_IO_write_ptr - f->_IO_write_base))
 	{
-	  count = new_do_write (f, s, do_write);
+	  count = new_do_writev (f, s, do_write);
 	  to_do -= count;
 	  if (count < do_write)
 	    return n - to_do;
 	}
+      else
+	{
+	  /* Next flush the (full) buffer. */
+	  if (_IO_OVERFLOW (f, EOF) == EOF)
+	    /* If nothing else has to be written we must not signal the
+	       caller that everything has been written.  */
+	    return to_do == 0 ? EOF : n - to_do;
+
+	  /* Try to maintain alignment: write a whole number of blocks.  */
+	  block_size = f->_IO_buf_end - f->_IO_buf_base;
+	  do_write = to_do - (block_size >= 128 ? to_do % block_size : 0);
+
+	  if (do_write)
+	    {
+	      count = new_do_write (f, s, do_write);
+	      to_do -= count;
+	      if (count < do_write)
+		return n - to_do;
+	    }
+	}
 
       /* Now write out the remainder.  Normally, this will fit in the
 	 buffer, but it's somewhat messier for line-buffered files,
@@ -1381,7 +1735,24 @@ _IO_file_xsgetn_mmap (FILE *fp, void *data, size_t n)
 	  have = fp->_IO_read_end - fp->_IO_read_ptr;
 	}
 
-      if (have < n)
+      /* In windowed mode, copy the rest of the current window and
+	 continue with the following ones.  */
+      while (have < n && (fp->_flags2 & _IO_FLAGS2_MMAP_WINDOW))
+	{
+	  s = __mempcpy (s, read_ptr, have);
+	  n -= have;
+	  fp->_IO_read_ptr = read_ptr + have;
+	  if (__glibc_unlikely (mmap_remap_check (fp)))
+	    /* We punted mmap, so complete with the vanilla code.  */
+	    return s - (char *) data + _IO_XSGETN (fp, s, n);
+
+	  read_ptr = fp->_IO_read_ptr;
+	  have = fp->_IO_read_end - read_ptr;
+	  if (have == 0)
+	    break;
+	}
+
+      if (have < n && (fp->_flags2 & _IO_FLAGS2_MMAP_WINDOW) == 0)
 	{
 	  /* Check that we are mapping all of the file, in case it grew.  */
 	  if (__glibc_unlikely (mmap_remap_check (fp)))
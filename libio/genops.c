@@ -585,6 +585,8 @@ _IO_no_init (FILE *fp, int flags, int orientation,
        stream.  */
     fp->_wide_data = (struct _IO_wide_data *) -1L;
   fp->_freeres_list = NULL;
+  /* No statistics, see __fstats.c.  */
+  fp->__pad5 = 0;
 }
 
 int
@@ -701,6 +703,7 @@ _IO_flush_all (void)
 	   || (_IO_vtable_offset (fp) == 0
 	       && fp->_mode > 0 && (fp->_wide_data->_IO_write_ptr
 				    > fp->_wide_data->_IO_write_base))
+	   || (fp->_flags2 & _IO_FLAGS2_THREAD_BUFFERED) != 0
 	   )
 	  && _IO_OVERFLOW (fp, EOF) == EOF)
 	result = EOF;
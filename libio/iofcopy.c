@@ -0,0 +1,150 @@
+/* Copy data from one stream to another.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include "libioP.h"
+#include <errno.h>
+#include <fcopy-fd.h>
+#include <stdbool.h>
+
+/* Write the data buffered by IN to OUT, up to COUNT bytes.  If DRAIN,
+   stop once the buffer of IN is empty, otherwise refill it until
+   COUNT bytes have been copied or the end of file is reached.  Return
+   the number of bytes copied.  */
+static size_t
+copy_buffered (FILE *in, FILE *out, size_t count, bool drain)
+{
+  size_t copied = 0;
+  while (copied < count)
+    {
+      size_t avail = in->_IO_read_end - in->_IO_read_ptr;
+      if (avail == 0)
+	{
+	  /* The main get area holds more data after the backup area
+	     of ungetc.  */
+	  if (drain && !_IO_in_backup (in))
+	    break;
+	  if (__underflow (in) == EOF)
+	    break;
+	  continue;
+	}
+      if (avail > count - copied)
+	avail = count - copied;
+      size_t written = _IO_sputn (out, in->_IO_read_ptr, avail);
+      in->_IO_read_ptr += written;
+      copied += written;
+      if (written < avail)
+	break;
+    }
+  return copied;
+}
+
+/* Return true if the data of FP can be passed directly to or from its
+   file descriptor once its buffer is empty.  */
+static bool
+fd_copy_usable (FILE *fp)
+{
+  return (_IO_JUMPS_FILE_plus (fp) == &_IO_file_jumps
+	  && fp->_fileno >= 0);
+}
+
+/* Copy up to COUNT bytes from IN to OUT.  */
+static size_t
+copy_locked (FILE *in, FILE *out, size_t count)
+{
+  if (_IO_fwide (in, -1) != -1 || _IO_fwide (out, -1) != -1)
+    {
+      __set_errno (EINVAL);
+      return 0;
+    }
+  if (_IO_in_put_mode (in) && _IO_switch_to_get_mode (in) == EOF)
+    return 0;
+
+  /* Data which IN has read ahead comes first.  */
+  size_t copied = copy_buffered (in, out, count, true);
+  /* Data left in the buffer means that writing to OUT failed.  */
+  if (copied == count || in->_IO_read_ptr < in->_IO_read_end)
+    return copied;
+  if (!fd_copy_usable (in) || !fd_copy_usable (out)
+      || (in->_flags & (_IO_NO_READS | _IO_EOF_SEEN)) != 0
+      || (out->_flags & _IO_NO_WRITES) != 0)
+    return copied + copy_buffered (in, out, count - copied, false);
+
+  /* The buffer of IN is empty now, so the offset of its descriptor is
+     the position of the stream.  Write out the buffer of OUT so that
+     the same holds for it.  */
+  if (_IO_SYNC (out) != 0)
+    return copied;
+
+  int state = 0;
+  while (copied < count)
+    {
+      ssize_t ret = __fcopy_fd (in->_fileno, out->_fileno, count - copied,
+				&state);
+      if (ret > 0)
+	{
+	  copied += ret;
+	  /* The offsets of the descriptors have moved.  */
+	  in->_offset = _IO_pos_BAD;
+	  out->_offset = _IO_pos_BAD;
+	}
+      else if (ret == 0)
+	{
+	  in->_flags |= _IO_EOF_SEEN;
+	  break;
+	}
+      else if (errno == ENOSYS)
+	/* No system call supports these descriptors.  */
+	return copied + copy_buffered (in, out, count - copied, false);
+      else
+	{
+	  /* The failing descriptor is not known.  */
+	  in->_flags |= _IO_ERR_SEEN;
+	  out->_flags |= _IO_ERR_SEEN;
+	  break;
+	}
+    }
+  return copied;
+}
+
+size_t
+__fcopy (FILE *in, FILE *out, size_t count)
+{
+  CHECK_FILE (in, 0);
+  CHECK_FILE (out, 0);
+  if (count == 0)
+    return 0;
+  if (in == out)
+    {
+      __set_errno (EINVAL);
+      return 0;
+    }
+
+  size_t copied;
+  /* Lock the streams in a fixed order, so that two threads copying
+     between the same streams in opposite directions do not
+     deadlock.  */
+  FILE *first = in < out ? in : out;
+  FILE *second = in < out ? out : in;
+  _IO_acquire_lock (first);
+  _IO_acquire_lock (second);
+  copied = copy_locked (in, out, count);
+  _IO_release_lock (second);
+  _IO_release_lock (first);
+  return copied;
+}
+weak_alias (__fcopy, fcopy)
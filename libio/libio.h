@@ -89,6 +89,15 @@ typedef struct
 #define _IO_FLAGS2_NOCLOSE 32
 #define _IO_FLAGS2_CLOEXEC 64
 #define _IO_FLAGS2_NEED_LOCK 128
+/* The last refill of the read buffer filled it completely, and it has
+   been consumed without seeking.  */
+#define _IO_FLAGS2_READ_SEQUENTIAL 256
+/* The stream maps a window of the file rather than all of it; see
+   mmap_window_map in fileops.c.  */
+#define _IO_FLAGS2_MMAP_WINDOW 512
+/* Output goes to per-thread buffers rather than the buffer of the
+   stream; see threadbuf.c.  */
+#define _IO_FLAGS2_THREAD_BUFFERED 1024
 
 /* _IO_pos_BAD is an off64_t value indicating error, unknown, or EOF.  */
 #define _IO_pos_BAD ((off64_t) -1)
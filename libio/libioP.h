@@ -36,6 +36,7 @@
 #define _LIBIOP_H 1
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <errno.h>
 #include <libc-lock.h>
@@ -533,6 +534,11 @@ extern const struct _IO_jump_t __io_vtables[] attribute_hidden;
 
 extern int _IO_do_write (FILE *, const char *, size_t);
 libc_hidden_proto (_IO_do_write)
+extern size_t _IO_thread_buffer_xsputn (FILE *, const void *, size_t)
+     attribute_hidden;
+extern int _IO_thread_buffer_overflow (FILE *, int) attribute_hidden;
+/* Write the output of the calling thread to FP.  */
+extern int _IO_thread_buffer_flush (FILE *) attribute_hidden;
 extern int _IO_new_do_write (FILE *, const char *, size_t);
 extern int _IO_old_do_write (FILE *, const char *, size_t);
 extern int _IO_wdo_write (FILE *, const wchar_t *, size_t);
@@ -585,10 +591,35 @@ extern void _IO_old_init (FILE *fp, int flags) __THROW;
 #define _IO_wblen(fp) ((fp)->_wide_data->_IO_buf_end \
 		       - (fp)->_wide_data->_IO_buf_base)
 
+/* Statistics of streams, collected if the glibc.stdio.stream_stats
+   tunable is set.  They are allocated for a stream when it is first
+   accounted for, and the unused __pad5 member of FILE points to
+   them.  See __fstats.c.  */
+struct __stdio_stats;
+extern bool _IO_stats_enabled attribute_hidden;
+extern struct __stdio_stats *_IO_stats_alloc (FILE *) attribute_hidden;
+extern void _IO_stats_free (FILE *) attribute_hidden;
+extern uint64_t _IO_stats_clock (void) attribute_hidden;
+
+#ifndef _IO_USE_OLD_IO_FILE
+/* Return the statistics of FP, or NULL if they are not collected.
+   Streams of old binaries lack the member holding them.  */
+static inline struct __stdio_stats *
+_IO_stats (FILE *fp)
+{
+  if (__glibc_likely (!_IO_stats_enabled) || _IO_vtable_offset (fp) != 0)
+    return NULL;
+  if (fp->__pad5 != 0)
+    return (struct __stdio_stats *) fp->__pad5;
+  return _IO_stats_alloc (fp);
+}
+#endif
+
 /* Jumptable functions for files. */
 
 extern int _IO_file_doallocate (FILE *) __THROW;
 libc_hidden_proto (_IO_file_doallocate)
+extern bool _IO_file_grow_buffer (FILE *) attribute_hidden;
 extern FILE* _IO_file_setbuf (FILE *, char *, ssize_t);
 libc_hidden_proto (_IO_file_setbuf)
 extern off64_t _IO_file_seekoff (FILE *, off64_t, int, int);
@@ -608,6 +639,7 @@ extern int _IO_file_underflow (FILE *);
 libc_hidden_proto (_IO_file_underflow)
 extern int _IO_file_underflow_mmap (FILE *);
 extern int _IO_file_underflow_maybe_mmap (FILE *);
+extern int _IO_file_mmap_window_move (FILE *) attribute_hidden;
 extern int _IO_file_overflow (FILE *, int);
 libc_hidden_proto (_IO_file_overflow)
 #define _IO_file_is_open(__fp) ((__fp)->_fileno != -1)
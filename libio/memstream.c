@@ -17,6 +17,8 @@
 
 #include "libioP.h"
 #include "strfile.h"
+#include <errno.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -77,6 +79,51 @@ libc_hidden_def (__open_memstream)
 weak_alias (__open_memstream, open_memstream)
 
 
+/* Return the buffer of the memstream FP, with the data written so far
+   and a terminating null byte, and store the size of the data in
+   *SIZELOC.  The buffer is handed over without copying it, and FP
+   continues writing at the start of a new buffer, which is allocated
+   on the next write.  */
+char *
+__memstream_detach (FILE *fp, size_t *sizeloc)
+{
+  if (_IO_JUMPS_FILE_plus (fp) != &_IO_mem_jumps)
+    {
+      __set_errno (EINVAL);
+      return NULL;
+    }
+
+  char *buf = NULL;
+  _IO_acquire_lock (fp);
+
+  /* Make room for the null byte, like _IO_mem_sync.  */
+  bool room = true;
+  if (fp->_IO_write_ptr == fp->_IO_write_end)
+    {
+      room = _IO_str_overflow (fp, '\0') != EOF;
+      if (room)
+	--fp->_IO_write_ptr;
+    }
+
+  if (room)
+    {
+      buf = fp->_IO_write_base;
+      *sizeloc = fp->_IO_write_ptr - fp->_IO_write_base;
+      buf[*sizeloc] = '\0';
+
+      /* The buffer now belongs to the caller.  */
+      fp->_IO_buf_base = NULL;
+      _IO_setb (fp, NULL, NULL, 1);
+      fp->_IO_read_base = fp->_IO_read_ptr = fp->_IO_read_end = NULL;
+      fp->_IO_write_base = fp->_IO_write_ptr = fp->_IO_write_end = NULL;
+    }
+
+  _IO_release_lock (fp);
+  return buf;
+}
+weak_alias (__memstream_detach, memstream_detach)
+
+
 int
 _IO_mem_sync (FILE *fp)
 {
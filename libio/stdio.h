@@ -319,6 +319,16 @@ extern FILE *fmemopen (void *__s, size_t __len, const char *__modes)
 extern FILE *open_memstream (char **__bufloc, size_t *__sizeloc) __THROW
   __attribute_malloc__ __attr_dealloc_fclose __wur;
 
+# ifdef __USE_GNU
+/* Return the buffer of STREAM, which must have been opened with
+   open_memstream, holding the characters written so far and a null
+   byte, and store their number in *SIZELOC.  The buffer is not copied
+   and must be freed by the caller.  STREAM continues writing into a
+   new buffer.  */
+extern char *memstream_detach (FILE *__stream, size_t *__sizeloc) __THROW
+  __wur;
+# endif
+
 #ifdef _WCHAR_H
 /* Like OPEN_MEMSTREAM, but the stream is wide oriented and produces
    a wide character string.  Declared here only to add attribute malloc
@@ -763,6 +773,18 @@ extern size_t fwrite_unlocked (const void *__restrict __ptr, size_t __size,
 			       size_t __n, FILE *__restrict __stream);
 #endif
 
+#ifdef __USE_GNU
+/* Copy up to COUNT bytes from IN to OUT, starting with the data
+   buffered by IN.  Between file descriptors, the data is passed by the
+   kernel where possible.  Return the number of bytes copied, which is
+   less than COUNT at the end of file of IN or on error.
+
+   This function is a possible cancellation point and therefore not
+   marked with __THROW.  */
+extern size_t fcopy (FILE *__restrict __in, FILE *__restrict __out,
+		     size_t __count);
+#endif
+
 
 /* Seek to a certain position on STREAM.
 
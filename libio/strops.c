@@ -30,6 +30,9 @@
 #include <string.h>
 #include <stdio_ext.h>
 
+#define TUNABLE_NAMESPACE stdio
+#include <elf/dl-tunables.h>
+
 void
 _IO_str_init_static_internal (_IO_strfile *sf, char *ptr, size_t size,
 			      char *pstart)
@@ -77,6 +80,18 @@ _IO_str_init_readonly (_IO_strfile *sf, const char *ptr, int size)
   sf->_sbf._f._flags |= _IO_NO_WRITES;
 }
 
+/* Return the size to which a full dynamic buffer of OLD_BLEN bytes
+   grows.  Large buffers can grow by a fixed step instead of doubling,
+   see the glibc.stdio.memstream_growth_step tunable.  */
+static size_t
+str_grow_size (size_t old_blen)
+{
+  size_t step = TUNABLE_GET (memstream_growth_step, size_t, NULL);
+  if (step != 0 && old_blen >= step)
+    return old_blen + step;
+  return 2 * old_blen + 100;
+}
+
 int
 _IO_str_overflow (FILE *fp, int c)
 {
@@ -100,29 +115,30 @@ _IO_str_overflow (FILE *fp, int c)
 	  char *new_buf;
 	  char *old_buf = fp->_IO_buf_base;
 	  size_t old_blen = _IO_blen (fp);
-	  size_t new_size = 2 * old_blen + 100;
+	  size_t new_size = str_grow_size (old_blen);
 	  if (new_size < old_blen)
 	    return EOF;
-	  new_buf = malloc (new_size);
+	  size_t read_base = fp->_IO_read_base - old_buf;
+	  size_t read_ptr = fp->_IO_read_ptr - old_buf;
+	  size_t read_end = fp->_IO_read_end - old_buf;
+	  size_t write_ptr = fp->_IO_write_ptr - old_buf;
+	  /* realloc can extend the buffer in place, or remap it if it
+	     was allocated with mmap, instead of copying it.  */
+	  new_buf = realloc (old_buf, new_size);
 	  if (new_buf == NULL)
 	    {
 	      /*	  __ferror(fp) = 1; */
 	      return EOF;
 	    }
-	  if (old_buf)
-	    {
-	      memcpy (new_buf, old_buf, old_blen);
-	      free (old_buf);
-	      /* Make sure _IO_setb won't try to delete _IO_buf_base. */
-	      fp->_IO_buf_base = NULL;
-	    }
+	  /* Make sure _IO_setb won't try to delete _IO_buf_base. */
+	  fp->_IO_buf_base = NULL;
 	  memset (new_buf + old_blen, '\0', new_size - old_blen);
 
 	  _IO_setb (fp, new_buf, new_buf + new_size, 1);
-	  fp->_IO_read_base = new_buf + (fp->_IO_read_base - old_buf);
-	  fp->_IO_read_ptr = new_buf + (fp->_IO_read_ptr - old_buf);
-	  fp->_IO_read_end = new_buf + (fp->_IO_read_end - old_buf);
-	  fp->_IO_write_ptr = new_buf + (fp->_IO_write_ptr - old_buf);
+	  fp->_IO_read_base = new_buf + read_base;
+	  fp->_IO_read_ptr = new_buf + read_ptr;
+	  fp->_IO_read_end = new_buf + read_end;
+	  fp->_IO_write_ptr = new_buf + write_ptr;
 
 	  fp->_IO_write_base = new_buf;
 	  fp->_IO_write_end = fp->_IO_buf_end;
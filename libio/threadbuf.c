@@ -0,0 +1,281 @@
+/* Per-thread output buffering of the standard streams.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Threads which write to the same stream serialize on its lock.  If
+   the glibc.stdio.thread_buffering tunable selects stdout or stderr,
+   that stream is switched at startup to a mode in which every thread
+   collects its output in a buffer of its own, and writes whole lines
+   from it directly to the file descriptor.  The stream gets
+   _IO_USER_LOCK, so the stdio functions do not lock it, and its own
+   buffer pointers stay null, so that all output ends up in the
+   overflow and xsputn functions of the file jump table.  These call
+   the functions below if _IO_FLAGS2_THREAD_BUFFERED is set.
+
+   The buffer of a thread is written out
+     - at the end of each output operation if the stream is unbuffered;
+     - up to its last newline at the end of each output operation if
+       the stream is line buffered;
+     - up to its last newline when it is full otherwise;
+     - completely on fflush, on a seek, when the stream is closed, when
+       the thread exits, and for the calling thread on exit.
+   Lines written by different threads are thus never mixed, unless a
+   line is longer than the buffer or the stream is flushed in the
+   middle of a line.  The output of other threads which has not been
+   written yet when the process exits is lost.
+
+   Wide-character output would go through the buffers of the stream,
+   so the streams are made byte-oriented when the mode is enabled.
+   __fpending always returns 0 for such a stream, because its own
+   buffer is never used.  Write errors are recorded in the stream
+   flags with an atomic operation, as the stream is not locked.  */
+
+#include <atomic.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <tls-internal.h>
+#include <unistd.h>
+#include "libioP.h"
+
+#define TUNABLE_NAMESPACE stdio
+#include <elf/dl-tunables.h>
+
+struct _IO_thread_buffer
+{
+  struct _IO_thread_buffer *next;
+  FILE *fp;
+  size_t size;
+  size_t used;
+  char data[];
+};
+
+/* Values of the glibc.stdio.thread_buffering tunable.  */
+#define THREAD_BUFFERING_STDOUT 1
+#define THREAD_BUFFERING_STDERR 2
+
+static void
+enable_thread_buffering (FILE *fp)
+{
+  if (fp->_mode != 0 || (fp->_flags & _IO_NO_WRITES))
+    return;
+  fp->_mode = -1;
+
+  /* Terminals are line buffered.  _IO_file_doallocate decides this
+     for other streams, but it is not called in this mode.  */
+  if ((fp->_flags & _IO_UNBUFFERED) == 0)
+    {
+      int save_errno = errno;
+      if (__isatty (fp->_fileno))
+	fp->_flags |= _IO_LINE_BUF;
+      __set_errno (save_errno);
+    }
+
+  fp->_flags |= _IO_USER_LOCK;
+  fp->_flags2 |= _IO_FLAGS2_THREAD_BUFFERED;
+}
+
+void
+_IO_thread_buffering_init (void)
+{
+  int32_t streams = TUNABLE_GET (thread_buffering, int32_t, NULL);
+  if (streams & THREAD_BUFFERING_STDOUT)
+    enable_thread_buffering ((FILE *) &_IO_2_1_stdout_);
+  if (streams & THREAD_BUFFERING_STDERR)
+    enable_thread_buffering ((FILE *) &_IO_2_1_stderr_);
+}
+
+/* Return the buffer of the calling thread for FP.  If it has none,
+   allocate one if ALLOCATE, else return NULL.  */
+static struct _IO_thread_buffer *
+get_buffer (FILE *fp, bool allocate)
+{
+  struct tls_internal_t *tls = __glibc_tls_internal ();
+  struct _IO_thread_buffer *b;
+  for (b = tls->stdio_thread_buffers; b != NULL; b = b->next)
+    if (b->fp == fp)
+      return b;
+  if (!allocate)
+    return NULL;
+
+  size_t size = TUNABLE_GET (buffer_size, size_t, NULL);
+  if (size == 0)
+    size = BUFSIZ;
+  b = malloc (sizeof (*b) + size);
+  if (b == NULL)
+    return NULL;
+  b->fp = fp;
+  b->size = size;
+  b->used = 0;
+  b->next = tls->stdio_thread_buffers;
+  tls->stdio_thread_buffers = b;
+  return b;
+}
+
+/* Write LEN1 bytes at DATA1 followed by LEN2 bytes at DATA2 to the file
+   descriptor of FP, with a single system call unless the write is
+   short.  Return false on error.  */
+static bool
+write_out (FILE *fp, const char *data1, size_t len1, const char *data2,
+	   size_t len2)
+{
+  struct iovec iov[2] =
+    {
+      { .iov_base = (void *) data1, .iov_len = len1 },
+      { .iov_base = (void *) data2, .iov_len = len2 }
+    };
+  struct iovec *iovp = iov;
+  int iovcnt = 2;
+
+  while (true)
+    {
+      while (iovcnt > 0 && iovp->iov_len == 0)
+	{
+	  ++iovp;
+	  --iovcnt;
+	}
+      if (iovcnt == 0)
+	return true;
+
+      ssize_t count = __writev (fp->_fileno, iovp, iovcnt);
+      if (count < 0)
+	{
+	  /* The stream is not locked, and other threads may record
+	     errors at the same time.  */
+	  atomic_fetch_or_relaxed (&fp->_flags, _IO_ERR_SEEN);
+	  return false;
+	}
+      while (iovcnt > 0 && (size_t) count >= iovp->iov_len)
+	{
+	  count -= iovp->iov_len;
+	  ++iovp;
+	  --iovcnt;
+	}
+      if (iovcnt > 0)
+	{
+	  iovp->iov_base = (char *) iovp->iov_base + count;
+	  iovp->iov_len -= count;
+	}
+    }
+}
+
+/* Write the first COUNT bytes of B, followed by LEN bytes at DATA, and
+   keep the rest of B.  The bytes are dropped on error.  */
+static bool
+flush_part (struct _IO_thread_buffer *b, size_t count, const char *data,
+	    size_t len)
+{
+  bool ok = write_out (b->fp, b->data, count, data, len);
+  b->used -= count;
+  memmove (b->data, b->data + count, b->used);
+  return ok;
+}
+
+/* Return the length of the complete lines at the start of the LEN
+   bytes at P.  */
+static size_t
+lines_length (const char *p, size_t len)
+{
+  const char *nl = __memrchr (p, '\n', len);
+  return nl == NULL ? 0 : nl - p + 1;
+}
+
+size_t
+_IO_thread_buffer_xsputn (FILE *fp, const void *data, size_t n)
+{
+  const char *s = data;
+  struct _IO_thread_buffer *b = get_buffer (fp, true);
+  if (__glibc_unlikely (b == NULL))
+    return write_out (fp, NULL, 0, s, n) ? n : 0;
+
+  bool ok;
+  if (n <= b->size - b->used)
+    {
+      memcpy (b->data + b->used, s, n);
+      b->used += n;
+      ok = true;
+    }
+  else
+    {
+      /* Write the complete lines of the buffer and the data together,
+	 and keep the incomplete line at the end if it fits.  */
+      size_t head = lines_length (s, n);
+      if (head > 0 && n - head <= b->size)
+	{
+	  ok = flush_part (b, b->used, s, head);
+	  memcpy (b->data, s + head, n - head);
+	  b->used = n - head;
+	}
+      else if (head == 0
+	       && n <= b->size - (b->used - lines_length (b->data, b->used)))
+	{
+	  ok = flush_part (b, lines_length (b->data, b->used), NULL, 0);
+	  memcpy (b->data + b->used, s, n);
+	  b->used += n;
+	}
+      else
+	/* A line does not fit into the buffer.  */
+	ok = flush_part (b, b->used, s, n);
+    }
+
+  if (ok && b->used > 0)
+    {
+      if (fp->_flags & _IO_UNBUFFERED)
+	ok = flush_part (b, b->used, NULL, 0);
+      else if (fp->_flags & _IO_LINE_BUF)
+	{
+	  size_t lines = lines_length (b->data, b->used);
+	  if (lines > 0)
+	    ok = flush_part (b, lines, NULL, 0);
+	}
+    }
+  return ok ? n : 0;
+}
+
+int
+_IO_thread_buffer_overflow (FILE *fp, int ch)
+{
+  if (ch == EOF)
+    return _IO_thread_buffer_flush (fp);
+  char c = ch;
+  if (_IO_thread_buffer_xsputn (fp, &c, 1) != 1)
+    return EOF;
+  return (unsigned char) ch;
+}
+
+int
+_IO_thread_buffer_flush (FILE *fp)
+{
+  struct _IO_thread_buffer *b = get_buffer (fp, false);
+  if (b == NULL || b->used == 0)
+    return 0;
+  return flush_part (b, b->used, NULL, 0) ? 0 : EOF;
+}
+
+void
+_IO_thread_buffers_free (struct _IO_thread_buffer *list)
+{
+  while (list != NULL)
+    {
+      struct _IO_thread_buffer *next = list->next;
+      write_out (list->fp, list->data, list->used, NULL, 0);
+      free (list);
+      list = next;
+    }
+}
@@ -0,0 +1,239 @@
+/* Test fcopy between different kinds of streams.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/temp_file.h>
+#include <support/xstdio.h>
+#include <support/xunistd.h>
+
+/* Larger than the stream buffers, and smaller than the capacity of a
+   pipe.  */
+#define DATA_SIZE 40000
+
+static char data[DATA_SIZE];
+static char *in_name;
+static char *out_name;
+
+/* Check that the file NAME holds the SIZE bytes at EXPECTED.  */
+static void
+check_contents (const char *name, const char *expected, size_t size)
+{
+  char *actual = xmalloc (size + 2);
+  FILE *fp = xfopen (name, "r");
+  TEST_COMPARE (fread (actual, 1, size + 2, fp), size);
+  xfclose (fp);
+  TEST_COMPARE_BLOB (actual, size, expected, size);
+  free (actual);
+}
+
+/* Check that the file NAME holds PREFIX, data[START..END) and
+   SUFFIX.  */
+static void
+check_file (const char *name, const char *prefix, size_t start, size_t end,
+	    const char *suffix)
+{
+  char *expected = xmalloc (strlen (prefix) + (end - start)
+			    + strlen (suffix) + 1);
+  char *p = stpcpy (expected, prefix);
+  p = mempcpy (p, data + start, end - start);
+  p = stpcpy (p, suffix);
+  check_contents (name, expected, p - expected);
+  free (expected);
+}
+
+static void
+truncate_out (void)
+{
+  xfclose (xfopen (out_name, "w"));
+}
+
+/* Copy between regular files, after data buffered by both streams.  */
+static void
+test_file_to_file (void)
+{
+  FILE *in = xfopen (in_name, "r");
+  FILE *out = xfopen (out_name, "w");
+  TEST_VERIFY (fputs ("header", out) >= 0);
+
+  /* Read ahead and push back a character.  */
+  TEST_COMPARE (fgetc (in), (unsigned char) data[0]);
+  TEST_COMPARE (fgetc (in), (unsigned char) data[1]);
+  TEST_COMPARE (ungetc ('X', in), 'X');
+
+  TEST_COMPARE (fcopy (in, out, 1000), 1000);
+  TEST_COMPARE (ftell (in), 1001);
+  TEST_COMPARE (fgetc (in), (unsigned char) data[1001]);
+
+  TEST_COMPARE (fcopy (in, out, SIZE_MAX), DATA_SIZE - 1002);
+  TEST_VERIFY (feof (in));
+  TEST_VERIFY (!ferror (in));
+  TEST_VERIFY (!ferror (out));
+  TEST_COMPARE (ftell (in), DATA_SIZE);
+  TEST_COMPARE (ftell (out), 6 + DATA_SIZE - 2);
+  TEST_COMPARE (fgetc (in), EOF);
+  TEST_COMPARE (fcopy (in, out, SIZE_MAX), 0);
+
+  TEST_VERIFY (fputs ("trailer", out) >= 0);
+  xfclose (out);
+  xfclose (in);
+
+  /* The character read by fgetc has not been copied.  */
+  char *expected = xmalloc (DATA_SIZE + 16);
+  char *p = mempcpy (expected, "headerX", 7);
+  p = mempcpy (p, data + 2, 999);
+  p = mempcpy (p, data + 1002, DATA_SIZE - 1002);
+  p = mempcpy (p, "trailer", 7);
+  check_contents (out_name, expected, p - expected);
+  free (expected);
+}
+
+/* Copy a part of the file to a stream which appends.  */
+static void
+test_append (void)
+{
+  truncate_out ();
+  FILE *out = xfopen (out_name, "a");
+  TEST_VERIFY (fputs ("first", out) >= 0);
+  TEST_COMPARE (fflush (out), 0);
+  FILE *in = xfopen (in_name, "r");
+  TEST_COMPARE (fseek (in, 100, SEEK_SET), 0);
+  TEST_COMPARE (fcopy (in, out, 5000), 5000);
+  TEST_COMPARE (ftell (in), 5100);
+  TEST_VERIFY (fputs ("last", out) >= 0);
+  xfclose (in);
+  xfclose (out);
+  check_file (out_name, "first", 100, 5100, "last");
+}
+
+/* Copy from a file to a pipe and from a pipe to a file.  */
+static void
+test_pipes (void)
+{
+  int fds[2];
+  xpipe (fds);
+  FILE *pipe_out = fdopen (fds[1], "w");
+  TEST_VERIFY_EXIT (pipe_out != NULL);
+  FILE *in = xfopen (in_name, "r");
+  TEST_VERIFY (fputs ("pipe", pipe_out) >= 0);
+  TEST_COMPARE (fcopy (in, pipe_out, SIZE_MAX), DATA_SIZE);
+  TEST_VERIFY (feof (in));
+  xfclose (in);
+  xfclose (pipe_out);
+
+  FILE *pipe_in = fdopen (fds[0], "r");
+  TEST_VERIFY_EXIT (pipe_in != NULL);
+  truncate_out ();
+  FILE *out = xfopen (out_name, "w");
+  TEST_COMPARE (fcopy (pipe_in, out, SIZE_MAX), 4 + DATA_SIZE);
+  TEST_VERIFY (feof (pipe_in));
+  xfclose (out);
+  xfclose (pipe_in);
+  check_file (out_name, "pipe", 0, DATA_SIZE, "");
+}
+
+/* Memory streams are copied through the buffers.  */
+static void
+test_memory_streams (void)
+{
+  char *buf;
+  size_t size;
+  FILE *out = open_memstream (&buf, &size);
+  TEST_VERIFY_EXIT (out != NULL);
+  FILE *in = xfopen (in_name, "r");
+  TEST_COMPARE (fcopy (in, out, SIZE_MAX), DATA_SIZE);
+  xfclose (in);
+  xfclose (out);
+  TEST_COMPARE (size, DATA_SIZE);
+  TEST_COMPARE_BLOB (buf, size, data, DATA_SIZE);
+
+  in = fmemopen (buf, size, "r");
+  TEST_VERIFY_EXIT (in != NULL);
+  truncate_out ();
+  out = xfopen (out_name, "w");
+  TEST_COMPARE (fcopy (in, out, 3000), 3000);
+  TEST_COMPARE (fcopy (in, out, SIZE_MAX), DATA_SIZE - 3000);
+  TEST_VERIFY (feof (in));
+  xfclose (out);
+  xfclose (in);
+  free (buf);
+  check_file (out_name, "", 0, DATA_SIZE, "");
+}
+
+static void
+test_errors (void)
+{
+  FILE *in = xfopen (in_name, "r");
+  FILE *out = xfopen (out_name, "r");
+
+  errno = 0;
+  TEST_COMPARE (fcopy (in, in, 10), 0);
+  TEST_COMPARE (errno, EINVAL);
+
+  /* OUT is not open for writing.  */
+  TEST_COMPARE (fcopy (in, out, 10), 0);
+  TEST_VERIFY (ferror (out));
+  xfclose (out);
+
+  /* Wide oriented streams are rejected.  */
+  out = xfopen (out_name, "w");
+  TEST_VERIFY (fwide (out, 1) > 0);
+  errno = 0;
+  TEST_COMPARE (fcopy (in, out, 10), 0);
+  TEST_COMPARE (errno, EINVAL);
+  xfclose (out);
+
+  /* IN is not open for reading.  */
+  out = xfopen (out_name, "w");
+  TEST_COMPARE (fcopy (out, stdout, 10), 0);
+  TEST_VERIFY (ferror (out));
+  xfclose (out);
+  xfclose (in);
+}
+
+static int
+do_test (void)
+{
+  for (size_t i = 0; i < DATA_SIZE; i++)
+    data[i] = 'a' + (i * 7 + i / 26) % 26;
+  int fd = create_temp_file ("tst-fcopy-in-", &in_name);
+  TEST_VERIFY_EXIT (fd >= 0);
+  xwrite (fd, data, DATA_SIZE);
+  xclose (fd);
+  fd = create_temp_file ("tst-fcopy-out-", &out_name);
+  TEST_VERIFY_EXIT (fd >= 0);
+  xclose (fd);
+
+  test_file_to_file ();
+  test_append ();
+  test_pipes ();
+  test_memory_streams ();
+  test_errors ();
+
+  free (in_name);
+  free (out_name);
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,227 @@
+/* Test the "m" fopen mode with mappings of file windows.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The test is run with glibc.stdio.mmap_window_size set to a small
+   value, so that the file spans many windows.  */
+
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/temp_file.h>
+#include <support/xstdio.h>
+#include <support/xunistd.h>
+
+static char *filename;
+static char *contents;
+static size_t contents_len;
+
+/* Write lines of varying length to the file.  */
+static void
+create_file (size_t nlines)
+{
+  FILE *fp = xfopen (filename, "w");
+  for (size_t i = 0; i < nlines; i++)
+    fprintf (fp, "line %zu %.*s\n", i, (int) (i % 97),
+	     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"
+	     "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz");
+  xfclose (fp);
+
+  free (contents);
+  fp = xfopen (filename, "r");
+  contents = xmalloc (nlines * 128);
+  contents_len = fread (contents, 1, nlines * 128, fp);
+  xfclose (fp);
+}
+
+static void
+test_getline (void)
+{
+  FILE *fp = xfopen (filename, "rm");
+  char *line = NULL;
+  size_t linesz = 0;
+  size_t pos = 0;
+  ssize_t n;
+  while ((n = getline (&line, &linesz, fp)) > 0)
+    {
+      if (pos + n > contents_len || memcmp (line, contents + pos, n) != 0)
+	FAIL_EXIT1 ("getline mismatch at offset %zu", pos);
+      pos += n;
+    }
+  TEST_COMPARE (pos, contents_len);
+  TEST_VERIFY (feof (fp));
+  TEST_COMPARE (ftell (fp), contents_len);
+  free (line);
+  xfclose (fp);
+}
+
+static void
+test_fread (size_t chunk)
+{
+  printf ("info: fread chunk size %zu\n", chunk);
+  FILE *fp = xfopen (filename, "rm");
+  char *buf = xmalloc (chunk);
+  size_t pos = 0;
+  size_t n;
+  while ((n = fread (buf, 1, chunk, fp)) > 0)
+    {
+      if (pos + n > contents_len || memcmp (buf, contents + pos, n) != 0)
+	FAIL_EXIT1 ("fread mismatch at offset %zu", pos);
+      pos += n;
+      TEST_COMPARE (ftell (fp), pos);
+    }
+  TEST_COMPARE (pos, contents_len);
+  TEST_VERIFY (feof (fp));
+  free (buf);
+  xfclose (fp);
+}
+
+static void
+check_getc (FILE *fp, long int pos)
+{
+  TEST_COMPARE (ftell (fp), pos);
+  if (pos < contents_len)
+    TEST_COMPARE (getc (fp), (unsigned char) contents[pos]);
+  else
+    TEST_COMPARE (getc (fp), EOF);
+}
+
+static void
+test_seek (void)
+{
+  FILE *fp = xfopen (filename, "rm");
+  char buf[100];
+  xfread (buf, 1, sizeof (buf), fp);
+
+  TEST_COMPARE (fseek (fp, contents_len / 2, SEEK_SET), 0);
+  check_getc (fp, contents_len / 2);
+  TEST_COMPARE (fseek (fp, -1000, SEEK_CUR), 0);
+  check_getc (fp, contents_len / 2 + 1 - 1000);
+  TEST_COMPARE (fseek (fp, 20000, SEEK_CUR), 0);
+  check_getc (fp, contents_len / 2 + 1 - 1000 + 1 + 20000);
+  TEST_COMPARE (fseek (fp, 10, SEEK_SET), 0);
+  check_getc (fp, 10);
+  TEST_COMPARE (fseek (fp, -5, SEEK_END), 0);
+  check_getc (fp, contents_len - 5);
+  TEST_COMPARE (fseek (fp, 0, SEEK_END), 0);
+  check_getc (fp, contents_len);
+  TEST_VERIFY (feof (fp));
+
+  /* Seeking past the end of the file is allowed.  */
+  TEST_COMPARE (fseek (fp, 12345, SEEK_END), 0);
+  TEST_VERIFY (!feof (fp));
+  check_getc (fp, contents_len + 12345);
+  TEST_COMPARE (ftell (fp), contents_len + 12345);
+  TEST_COMPARE (fseek (fp, 1, SEEK_SET), 0);
+  check_getc (fp, 1);
+
+  /* The descriptor is positioned at the stream position by fflush.  */
+  TEST_COMPARE (fseek (fp, 3 * contents_len / 4, SEEK_SET), 0);
+  xfread (buf, 1, 10, fp);
+  TEST_COMPARE (fflush (fp), 0);
+  TEST_COMPARE (lseek (fileno (fp), 0, SEEK_CUR), 3 * contents_len / 4 + 10);
+  check_getc (fp, 3 * contents_len / 4 + 10);
+
+  /* Put back a character at the start of a window.  */
+  TEST_COMPARE (fseek (fp, 8192, SEEK_SET), 0);
+  check_getc (fp, 8192);
+  TEST_COMPARE (ungetc ('!', fp), '!');
+  TEST_COMPARE (getc (fp), '!');
+  check_getc (fp, 8193);
+  xfclose (fp);
+}
+
+static void
+test_growth (void)
+{
+  FILE *fp = xfopen (filename, "rm");
+  char *buf = xmalloc (contents_len + 1);
+  TEST_COMPARE (fread (buf, 1, contents_len + 1, fp), contents_len);
+  TEST_VERIFY (feof (fp));
+
+  /* Data appended to the file is picked up after the end of file
+     indicator is cleared.  */
+  FILE *fpa = xfopen (filename, "a");
+  fputs ("appended\n", fpa);
+  xfclose (fpa);
+  clearerr (fp);
+  char line[32];
+  TEST_VERIFY (fgets (line, sizeof (line), fp) != NULL);
+  TEST_COMPARE_STRING (line, "appended\n");
+  TEST_COMPARE (getc (fp), EOF);
+  TEST_COMPARE (ftell (fp), contents_len + strlen ("appended\n"));
+
+  free (buf);
+  xfclose (fp);
+}
+
+static void
+test_wide (void)
+{
+  /* Characters of two and three bytes straddle the ends of the
+     windows.  */
+  xsetlocale (LC_ALL, "C.UTF-8");
+  FILE *fp = xfopen (filename, "w");
+  for (int i = 0; i < 50000; i++)
+    fputs (i % 3 == 0 ? "\xc3\xa4" : "\xe2\x82\xac", fp);
+  xfclose (fp);
+
+  fp = xfopen (filename, "rm");
+  for (int i = 0; i < 50000; i++)
+    {
+      wint_t wc = fgetwc (fp);
+      if (wc != (i % 3 == 0 ? L'ä' : L'€'))
+	FAIL_EXIT1 ("fgetwc returned %#x for character %d", (unsigned) wc, i);
+    }
+  TEST_COMPARE (fgetwc (fp), WEOF);
+  TEST_VERIFY (feof (fp));
+  TEST_VERIFY (!ferror (fp));
+  xfclose (fp);
+}
+
+static int
+do_test (void)
+{
+  int fd = create_temp_file ("tst-fopen-mmap-window.", &filename);
+  TEST_VERIFY_EXIT (fd >= 0);
+  xclose (fd);
+
+  create_file (20000);
+  test_getline ();
+  test_fread (1);
+  test_fread (1000);
+  test_fread (100000);
+  test_seek ();
+  test_growth ();
+
+  /* A file which is smaller than a window.  */
+  create_file (10);
+  test_getline ();
+  test_fread (1000);
+
+  test_wide ();
+
+  free (contents);
+  free (filename);
+  return 0;
+}
+
+#include <support/test-driver.c>
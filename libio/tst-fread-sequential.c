@@ -0,0 +1,160 @@
+/* Test sequential reads which make the stream buffer grow.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The buffer of a stream which is read sequentially is replaced by a
+   larger one on refill.  Check that the data and the file position
+   stay correct across the replacements, and after seeks and writes.  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/temp_file.h>
+#include <support/xstdio.h>
+#include <support/xunistd.h>
+
+/* Larger than the default limit of the buffer size, and not a
+   multiple of a power of two.  */
+#define FILE_SIZE (3 * 1024 * 1024 + 4321)
+
+static char *filename;
+static char *contents;
+
+static void
+test_getc (void)
+{
+  FILE *fp = xfopen (filename, "r");
+  for (size_t i = 0; i < FILE_SIZE; i++)
+    {
+      int c = getc (fp);
+      if (c != (unsigned char) contents[i])
+	FAIL_EXIT1 ("getc at offset %zu: %d != %d", i, c,
+		    (unsigned char) contents[i]);
+      if (i % 100003 == 0)
+	TEST_COMPARE (ftell (fp), i + 1);
+    }
+  TEST_COMPARE (getc (fp), EOF);
+  TEST_VERIFY (feof (fp));
+  TEST_COMPARE (ftell (fp), FILE_SIZE);
+  xfclose (fp);
+}
+
+static void
+test_fread (size_t chunk)
+{
+  printf ("info: fread chunk size %zu\n", chunk);
+  FILE *fp = xfopen (filename, "r");
+  char *buf = xmalloc (chunk);
+  size_t pos = 0;
+  while (pos < FILE_SIZE)
+    {
+      size_t n = fread (buf, 1, chunk, fp);
+      size_t expected = FILE_SIZE - pos < chunk ? FILE_SIZE - pos : chunk;
+      TEST_COMPARE (n, expected);
+      if (memcmp (buf, contents + pos, n) != 0)
+	FAIL_EXIT1 ("fread data mismatch at offset %zu", pos);
+      pos += n;
+    }
+  TEST_COMPARE (fread (buf, 1, chunk, fp), 0);
+  TEST_VERIFY (feof (fp));
+  free (buf);
+  xfclose (fp);
+}
+
+static void
+test_seek (void)
+{
+  FILE *fp = xfopen (filename, "r");
+  char buf[100];
+
+  /* Read far enough for the buffer to grow, then seek backwards and
+     forwards and keep reading sequentially.  */
+  static const long offsets[] =
+    { 2 * 1024 * 1024, 17, FILE_SIZE - 1000, 1024 * 1024 - 50 };
+  size_t pos = 0;
+  for (size_t i = 0; i < sizeof (offsets) / sizeof (offsets[0]); i++)
+    {
+      while (pos + sizeof (buf) <= (size_t) offsets[i])
+	{
+	  xfread (buf, 1, sizeof (buf), fp);
+	  TEST_COMPARE_BLOB (buf, sizeof (buf), contents + pos, sizeof (buf));
+	  pos += sizeof (buf);
+	}
+      TEST_COMPARE (ftell (fp), pos);
+      TEST_COMPARE (fseek (fp, offsets[i], SEEK_SET), 0);
+      pos = offsets[i];
+      xfread (buf, 1, 10, fp);
+      TEST_COMPARE_BLOB (buf, 10, contents + pos, 10);
+      pos += 10;
+    }
+
+  /* Push back a character after the buffer has grown.  */
+  TEST_COMPARE (ungetc ('!', fp), '!');
+  TEST_COMPARE (getc (fp), '!');
+  TEST_COMPARE (getc (fp), (unsigned char) contents[pos]);
+  xfclose (fp);
+}
+
+static void
+test_update (void)
+{
+  /* Switch from reading to writing after the buffer has grown.  */
+  FILE *fp = xfopen (filename, "r+");
+  size_t pos = 0;
+  while (pos < 2 * 1024 * 1024)
+    {
+      TEST_COMPARE (getc (fp), (unsigned char) contents[pos]);
+      pos++;
+    }
+  TEST_COMPARE (fseek (fp, 0, SEEK_CUR), 0);
+  TEST_COMPARE (fputs ("updated", fp) >= 0, 1);
+  memcpy (contents + pos, "updated", strlen ("updated"));
+  pos += strlen ("updated");
+  TEST_COMPARE (fseek (fp, 0, SEEK_CUR), 0);
+  TEST_COMPARE (getc (fp), (unsigned char) contents[pos]);
+  xfclose (fp);
+
+  test_fread (4096);
+}
+
+static int
+do_test (void)
+{
+  int fd = create_temp_file ("tst-fread-sequential.", &filename);
+  TEST_VERIFY_EXIT (fd >= 0);
+  contents = xmalloc (FILE_SIZE);
+  for (size_t i = 0; i < FILE_SIZE; i++)
+    contents[i] = 'a' + (i * 7 + i / 4096) % 26;
+  xwrite (fd, contents, FILE_SIZE);
+  xclose (fd);
+
+  test_getc ();
+  test_fread (1);
+  test_fread (100);
+  test_fread (4096);
+  test_fread (65536 + 1);
+  test_seek ();
+  test_update ();
+
+  free (contents);
+  free (filename);
+  return 0;
+}
+
+#include <support/test-driver.c>
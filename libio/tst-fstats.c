@@ -0,0 +1,148 @@
+/* Test the stream statistics returned by __fstats.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The test runs with glibc.stdio.stream_stats=1.  */
+
+#include <stdio.h>
+#include <stdio_ext.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/temp_file.h>
+#include <support/xstdio.h>
+#include <support/xunistd.h>
+
+/* Larger than the stream buffers.  */
+#define DATA_SIZE 100000
+
+static char data[DATA_SIZE];
+
+static struct __stdio_stats
+get_stats (FILE *fp)
+{
+  struct __stdio_stats stats;
+  memset (&stats, 0xff, sizeof (stats));
+  TEST_COMPARE (__fstats (fp, &stats), 0);
+  return stats;
+}
+
+static void
+check_zero (FILE *fp)
+{
+  struct __stdio_stats stats = get_stats (fp);
+  struct __stdio_stats zero;
+  memset (&zero, 0, sizeof (zero));
+  TEST_COMPARE_BLOB (&stats, sizeof (stats), &zero, sizeof (zero));
+}
+
+static void
+test_write (const char *name)
+{
+  FILE *fp = xfopen (name, "w");
+  check_zero (fp);
+
+  /* A small write stays in the buffer until fflush.  */
+  TEST_COMPARE (fwrite ("abc", 1, 3, fp), 3);
+  struct __stdio_stats stats = get_stats (fp);
+  TEST_COMPARE (stats.write_calls, 0);
+  TEST_COMPARE (stats.buffer_allocations, 1);
+  TEST_COMPARE (fflush (fp), 0);
+  stats = get_stats (fp);
+  TEST_COMPARE (stats.write_calls, 1);
+  TEST_COMPARE (stats.flushes, 1);
+  TEST_COMPARE (stats.bytes_written, 3);
+  TEST_COMPARE (stats.bytes_written_buffered, 3);
+
+  /* Most of a large write bypasses the buffer.  */
+  TEST_COMPARE (fwrite ("def", 1, 3, fp), 3);
+  TEST_COMPARE (fwrite (data, 1, DATA_SIZE, fp), DATA_SIZE);
+  TEST_COMPARE (fflush (fp), 0);
+  stats = get_stats (fp);
+  TEST_VERIFY (stats.write_calls >= 2);
+  TEST_VERIFY (stats.flushes >= 2);
+  TEST_COMPARE (stats.bytes_written, 6 + DATA_SIZE);
+  TEST_VERIFY (stats.bytes_written_buffered >= 6);
+  TEST_VERIFY (stats.bytes_written_buffered < DATA_SIZE);
+  TEST_COMPARE (stats.read_calls, 0);
+  TEST_COMPARE (stats.bytes_read, 0);
+
+  TEST_COMPARE (fseek (fp, 0, SEEK_SET), 0);
+  TEST_VERIFY (get_stats (fp).seek_calls > stats.seek_calls);
+  xfclose (fp);
+}
+
+static void
+test_read (const char *name)
+{
+  FILE *fp = xfopen (name, "r");
+  check_zero (fp);
+
+  /* A single character fills the buffer.  */
+  TEST_COMPARE (fgetc (fp), 'a');
+  struct __stdio_stats stats = get_stats (fp);
+  TEST_COMPARE (stats.read_calls, 1);
+  TEST_COMPARE (stats.buffer_allocations, 1);
+  TEST_VERIFY (stats.bytes_read > 1);
+  TEST_COMPARE (stats.bytes_read_buffered, stats.bytes_read);
+
+  char *buf = xmalloc (DATA_SIZE + 6);
+  TEST_COMPARE (fread (buf, 1, DATA_SIZE + 6, fp), DATA_SIZE + 5);
+  TEST_VERIFY (feof (fp));
+  TEST_COMPARE_BLOB (buf, 5, "bcdef", 5);
+  TEST_COMPARE_BLOB (buf + 5, DATA_SIZE, data, DATA_SIZE);
+  free (buf);
+  stats = get_stats (fp);
+  TEST_VERIFY (stats.read_calls >= 3);
+  TEST_COMPARE (stats.bytes_read, 6 + DATA_SIZE);
+  TEST_VERIFY (stats.bytes_read_buffered < stats.bytes_read);
+  TEST_COMPARE (stats.write_calls, 0);
+  TEST_COMPARE (stats.bytes_written, 0);
+  TEST_COMPARE (stats.flushes, 0);
+  xfclose (fp);
+}
+
+static int
+do_test (void)
+{
+  for (size_t i = 0; i < DATA_SIZE; i++)
+    data[i] = 'a' + i % 26;
+  char *name;
+  int fd = create_temp_file ("tst-fstats-", &name);
+  TEST_VERIFY_EXIT (fd >= 0);
+  xclose (fd);
+
+  test_write (name);
+  test_read (name);
+
+  /* Streams without a file descriptor do not count anything.  */
+  char *buf;
+  size_t size;
+  FILE *fp = open_memstream (&buf, &size);
+  TEST_VERIFY_EXIT (fp != NULL);
+  TEST_VERIFY (fputs ("memory", fp) >= 0);
+  TEST_COMPARE (fflush (fp), 0);
+  check_zero (fp);
+  xfclose (fp);
+  free (buf);
+
+  free (name);
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,148 @@
+/* Test fwrite of data which does not fit into the stream buffer.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The buffered data and the new data are written with a single writev
+   in this case.  Check the file contents and the file position for
+   the different kinds of streams.  */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/temp_file.h>
+#include <support/xstdio.h>
+#include <support/xunistd.h>
+
+#define BUFFER_SIZE 4096
+
+/* Larger than the buffer and not a multiple of its size, so that the
+   remainder ends up in the buffer.  */
+#define BIG_SIZE (3 * BUFFER_SIZE + 123)
+
+static char *filename;
+static char expected[5 * BIG_SIZE];
+static size_t expected_len;
+
+static void
+fill (char *p, size_t len, int seed)
+{
+  for (size_t i = 0; i < len; i++)
+    p[i] = 'a' + (i * 7 + seed) % 26;
+}
+
+static void
+write_and_expect (FILE *fp, size_t len, int seed)
+{
+  char *data = xmalloc (len);
+  fill (data, len, seed);
+  TEST_COMPARE (fwrite (data, 1, len, fp), len);
+  memcpy (expected + expected_len, data, len);
+  expected_len += len;
+  free (data);
+}
+
+static void
+check_file (void)
+{
+  FILE *fp = xfopen (filename, "r");
+  char *contents = xmalloc (expected_len + 1);
+  TEST_COMPARE (fread (contents, 1, expected_len + 1, fp), expected_len);
+  TEST_COMPARE_BLOB (contents, expected_len, expected, expected_len);
+  xfclose (fp);
+  free (contents);
+}
+
+static void
+test_mode (const char *mode, int bufmode)
+{
+  printf ("info: mode \"%s\", buffering %d\n", mode, bufmode);
+
+  /* Start with some contents for the append and update modes.  */
+  FILE *fp = xfopen (filename, "w");
+  expected_len = 0;
+  write_and_expect (fp, 1000, 0);
+  xfclose (fp);
+  if (mode[0] == 'w')
+    expected_len = 0;
+
+  fp = xfopen (filename, mode);
+  TEST_COMPARE (setvbuf (fp, NULL, bufmode, BUFFER_SIZE), 0);
+  if (mode[0] == 'r')
+    {
+      /* Fill the read buffer, then switch to writing in the middle of
+	 the file.  The position of the descriptor is at the end of the
+	 read data.  */
+      char buf[10];
+      xfread (buf, 1, sizeof (buf), fp);
+      TEST_COMPARE (fseek (fp, 0, SEEK_CUR), 0);
+      expected_len = sizeof (buf);
+    }
+
+  write_and_expect (fp, 10, 1);
+  write_and_expect (fp, BIG_SIZE, 2);
+  TEST_COMPARE (ftell (fp), expected_len);
+  write_and_expect (fp, 100, 3);
+  write_and_expect (fp, BIG_SIZE, 4);
+  write_and_expect (fp, 2 * BIG_SIZE, 5);
+  TEST_COMPARE (ftell (fp), expected_len);
+  xfclose (fp);
+
+  check_file ();
+}
+
+static void
+test_error (void)
+{
+  FILE *fp = xfopen (filename, "w");
+  TEST_COMPARE (setvbuf (fp, NULL, _IOFBF, BUFFER_SIZE), 0);
+  char data[BIG_SIZE];
+  fill (data, sizeof (data), 6);
+  TEST_COMPARE (fwrite (data, 1, 10, fp), 10);
+
+  /* Only the data which fits into the buffer is accepted if the
+     buffer cannot be flushed.  */
+  xclose (fileno (fp));
+  errno = 0;
+  TEST_COMPARE (fwrite (data, 1, sizeof (data), fp), BUFFER_SIZE - 10);
+  TEST_COMPARE (errno, EBADF);
+  TEST_VERIFY (ferror (fp));
+  fclose (fp);
+}
+
+static int
+do_test (void)
+{
+  int fd = create_temp_file ("tst-fwrite-writev.", &filename);
+  TEST_VERIFY_EXIT (fd >= 0);
+  xclose (fd);
+
+  test_mode ("w", _IOFBF);
+  test_mode ("w", _IOLBF);
+  test_mode ("a", _IOFBF);
+  test_mode ("r+", _IOFBF);
+  test_mode ("a+", _IOFBF);
+  test_error ();
+
+  free (filename);
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,128 @@
+/* Test memstream_detach and the growth of open_memstream buffers.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The test runs with glibc.stdio.memstream_growth_step=5000, so that
+   the large messages below grow their buffers by steps.  */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <support/check.h>
+#include <support/xstdio.h>
+
+/* Write a message of LENGTH characters to FP, which is reproduced by
+   check_message.  */
+static void
+write_message (FILE *fp, int id, size_t length)
+{
+  for (size_t i = 0; i < length; i++)
+    TEST_VERIFY (fputc ('a' + (id + i) % 26, fp) != EOF);
+}
+
+static void
+check_message (const char *buf, size_t size, int id, size_t length)
+{
+  TEST_COMPARE (size, length);
+  for (size_t i = 0; i < length; i++)
+    if (buf[i] != 'a' + (id + i) % 26)
+      {
+	support_record_failure ();
+	printf ("error: message %d: mismatch at offset %zu\n", id, i);
+	break;
+      }
+  TEST_COMPARE (buf[length], '\0');
+}
+
+static int
+do_test (void)
+{
+  static const size_t lengths[] =
+    { 0, 1, 99, 100, 101, 4999, 5000, 5001, 12345, 300000, 10, 0, 77 };
+  char *buf;
+  size_t size;
+  FILE *fp = open_memstream (&buf, &size);
+  TEST_VERIFY_EXIT (fp != NULL);
+
+  /* Detach a series of messages from the same stream.  */
+  for (int id = 0; id < sizeof (lengths) / sizeof (lengths[0]); id++)
+    {
+      write_message (fp, id, lengths[id]);
+      size_t detached_size = -1;
+      char *detached = memstream_detach (fp, &detached_size);
+      TEST_VERIFY_EXIT (detached != NULL);
+      check_message (detached, detached_size, id, lengths[id]);
+      free (detached);
+    }
+
+  /* Output after a detach ends up in the buffer stored by fflush and
+     fclose.  */
+  TEST_VERIFY (fputs ("tail", fp) >= 0);
+  TEST_COMPARE (fflush (fp), 0);
+  TEST_COMPARE_STRING (buf, "tail");
+  TEST_COMPARE (size, 4);
+  char *detached = memstream_detach (fp, &size);
+  TEST_COMPARE_STRING (detached, "tail");
+  free (detached);
+  xfclose (fp);
+  TEST_COMPARE_STRING (buf, "");
+  TEST_COMPARE (size, 0);
+  free (buf);
+
+  /* Only the data up to the current position is returned, as by
+     fclose.  */
+  fp = open_memstream (&buf, &size);
+  TEST_VERIFY_EXIT (fp != NULL);
+  TEST_VERIFY (fputs ("0123456789", fp) >= 0);
+  TEST_COMPARE (fseek (fp, 4, SEEK_SET), 0);
+  TEST_VERIFY (fputs ("x", fp) >= 0);
+  detached = memstream_detach (fp, &size);
+  TEST_COMPARE_STRING (detached, "0123x");
+  TEST_COMPARE (size, 5);
+  free (detached);
+  /* Seeking past the end of the new buffer fills the gap with
+     zeroes.  */
+  TEST_COMPARE (fseek (fp, 3, SEEK_SET), 0);
+  TEST_VERIFY (fputs ("y", fp) >= 0);
+  xfclose (fp);
+  TEST_COMPARE (size, 4);
+  TEST_COMPARE_BLOB (buf, 5, "\0\0\0y", 5);
+  free (buf);
+
+  /* Other streams are rejected.  */
+  fp = fmemopen (NULL, 10, "w");
+  TEST_VERIFY_EXIT (fp != NULL);
+  errno = 0;
+  TEST_VERIFY (memstream_detach (fp, &size) == NULL);
+  TEST_COMPARE (errno, EINVAL);
+  xfclose (fp);
+
+  wchar_t *wbuf;
+  fp = open_wmemstream (&wbuf, &size);
+  TEST_VERIFY_EXIT (fp != NULL);
+  errno = 0;
+  TEST_VERIFY (memstream_detach (fp, &size) == NULL);
+  TEST_COMPARE (errno, EINVAL);
+  xfclose (fp);
+  free (wbuf);
+
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,208 @@
+/* Test per-thread buffering of stdout.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The test runs with glibc.stdio.thread_buffering=1 and 256-byte
+   buffers.  Several threads write lines to stdout, which is redirected
+   to a file, with different stdio functions.  Each line must come out
+   intact, and the lines of a thread in order.  */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <wchar.h>
+#include <support/check.h>
+#include <support/support.h>
+#include <support/temp_file.h>
+#include <support/xstdio.h>
+#include <support/xthread.h>
+#include <support/xunistd.h>
+
+enum { nthreads = 8, nlines = 2000 };
+
+/* Write line NUMBER of thread ID.  Lines are split across several
+   calls, and their length varies up to about 160 bytes.  */
+static void
+write_line (int id, int number)
+{
+  int length = (number * 37 + id) % 120;
+  switch (number % 4)
+    {
+    case 0:
+      printf ("%d %d ", id, number);
+      for (int i = 0; i < length; i++)
+	putchar ('a' + (id + i) % 26);
+      putchar ('\n');
+      break;
+    case 1:
+      printf ("%d %d %.*s\n", id, number, length,
+	      "bcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyzabcdefghij"
+	      "klmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyzabcdefghijklmnopqr"
+	      "stuvwxyzabcdefghijklmnopqrstuvwxyz");
+      break;
+    case 2:
+      {
+	char buf[200];
+	int n = snprintf (buf, sizeof (buf), "%d %d ", id, number);
+	memset (buf + n, 'x', length);
+	fwrite (buf, 1, n + length, stdout);
+	fputs ("\n", stdout);
+      }
+      break;
+    default:
+      {
+	/* Two lines in one call.  */
+	char buf[400];
+	int n = snprintf (buf, sizeof (buf), "%d %d \n%d %d ", id, number,
+			  id, -number);
+	memset (buf + n, 'y', length);
+	strcpy (buf + n + length, "\n");
+	fputs (buf, stdout);
+      }
+      break;
+    }
+}
+
+static void *
+thread_func (void *closure)
+{
+  int id = (int) (long int) closure;
+  for (int i = 0; i < nlines; i++)
+    write_line (id, i);
+  /* The thread exits with output in its buffer, which is written at
+     thread exit.  */
+  printf ("%d end\n", id);
+  return NULL;
+}
+
+/* Check that LINE is a complete line written by write_line or as the
+   last line of a thread, and that it follows the previous line of the
+   same thread in NEXT.  */
+static void
+check_line (const char *line, int *next)
+{
+  int id, number, n;
+  if (sscanf (line, "%d %d %n", &id, &number, &n) != 2)
+    {
+      n = -1;
+      if (sscanf (line, "%d end%n", &id, &n) == 1 && id >= 0
+	  && id < nthreads && n > 0 && line[n] == '\0')
+	{
+	  TEST_COMPARE (next[id], nlines);
+	  next[id] = -1;
+	  return;
+	}
+      FAIL_EXIT1 ("invalid line: %s", line);
+    }
+  TEST_VERIFY_EXIT (id >= 0 && id < nthreads);
+
+  if (number < 0)
+    {
+      /* Second line of case 3.  */
+      TEST_COMPARE (-number, next[id] - 1);
+      TEST_COMPARE (-number % 4, 3);
+      int length = (-number * 37 + id) % 120;
+      TEST_COMPARE (strlen (line + n), length);
+      TEST_COMPARE (strspn (line + n, "y"), length);
+      return;
+    }
+
+  TEST_COMPARE (number, next[id]);
+  next[id] = number + 1;
+  int length = (number * 37 + id) % 120;
+  if (number % 4 == 3)
+    length = 0;
+  TEST_COMPARE (strlen (line + n), length);
+  if (number % 4 == 2)
+    TEST_COMPARE (strspn (line + n, "x"), length);
+}
+
+static int
+do_test (void)
+{
+  /* The stream is oriented for bytes.  */
+  TEST_VERIFY (fwide (stdout, 0) < 0);
+  TEST_VERIFY (fwide (stdout, 1) < 0);
+  TEST_VERIFY (wprintf (L"wide\n") < 0);
+
+  char *path;
+  int fd = create_temp_file ("tst-stdout-thread-buffering-", &path);
+  TEST_VERIFY_EXIT (fd >= 0);
+  int saved_stdout = xdup (STDOUT_FILENO);
+  xdup2 (fd, STDOUT_FILENO);
+
+  pthread_t threads[nthreads];
+  for (int i = 0; i < nthreads; i++)
+    threads[i] = xpthread_create (NULL, thread_func, (void *) (long int) i);
+  for (int i = 0; i < nthreads; i++)
+    xpthread_join (threads[i]);
+
+  /* A line longer than the buffer, and output of this thread which
+     is pending until the fflush call.  */
+  char *long_line = xmalloc (1001);
+  memset (long_line, 'z', 1000);
+  long_line[1000] = '\0';
+  printf ("%s\n", long_line);
+  fputs ("last", stdout);
+  TEST_COMPARE (fflush (stdout), 0);
+  TEST_COMPARE (ferror (stdout), 0);
+
+  xdup2 (saved_stdout, STDOUT_FILENO);
+  xclose (saved_stdout);
+
+  FILE *fp = xfopen (path, "r");
+  int next[nthreads] = { 0 };
+  char *line = NULL;
+  size_t line_length = 0;
+  ssize_t ret;
+  int lines = 0;
+  bool seen_long = false;
+  while ((ret = getline (&line, &line_length, fp)) > 0)
+    {
+      ++lines;
+      if (line[ret - 1] == '\n')
+	line[ret - 1] = '\0';
+      else
+	{
+	  /* The output of the last fflush.  */
+	  TEST_COMPARE_STRING (line, "last");
+	  TEST_VERIFY (seen_long);
+	  continue;
+	}
+      if (line[0] == 'z')
+	{
+	  TEST_COMPARE_STRING (line, long_line);
+	  seen_long = true;
+	  continue;
+	}
+      check_line (line, next);
+    }
+  TEST_VERIFY (feof (fp));
+  for (int i = 0; i < nthreads; i++)
+    TEST_COMPARE (next[i], -1);
+  TEST_COMPARE (lines, nthreads * (nlines + nlines / 4 + 1) + 2);
+
+  free (line);
+  free (long_line);
+  xfclose (fp);
+  free (path);
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -28,6 +28,7 @@
 #include <libioP.h>
 #include <wchar.h>
 #include <gconv.h>
+#include <stdio_ext.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -239,6 +240,9 @@ _IO_wfile_underflow (FILE *fp)
       else
 	fp->_flags |= _IO_ERR_SEEN, count = 0;
     }
+  struct __stdio_stats *stats = _IO_stats (fp);
+  if (stats != NULL)
+    stats->bytes_read_buffered += count;
   fp->_IO_read_end += count;
   if (count == 0)
     {
@@ -353,9 +357,6 @@ _IO_wfile_underflow_mmap (FILE *fp)
        flags as appropriate.  */
     return WEOF;
 
-  /* There is more in the external.  Convert it.  */
-  read_stop = (const char *) fp->_IO_read_ptr;
-
   if (fp->_wide_data->_IO_buf_base == NULL)
     {
       /* Maybe we already have a push back pointer.  */
@@ -367,6 +368,10 @@ _IO_wfile_underflow_mmap (FILE *fp)
       _IO_wdoallocbuf (fp);
     }
 
+ convert:
+  /* There is more in the external.  Convert it.  */
+  read_stop = (const char *) fp->_IO_read_ptr;
+
   fp->_wide_data->_IO_last_state = fp->_wide_data->_IO_state;
   fp->_wide_data->_IO_read_base = fp->_wide_data->_IO_read_ptr =
     fp->_wide_data->_IO_buf_base;
@@ -383,6 +388,19 @@ _IO_wfile_underflow_mmap (FILE *fp)
   if (fp->_wide_data->_IO_read_ptr < fp->_wide_data->_IO_read_end)
     return *fp->_wide_data->_IO_read_ptr;
 
+  /* If only a window of the file is mapped, the bytes left may be an
+     incomplete character at the end of the window.  Move the window
+     to them and try again.  */
+  if (fp->_flags2 & _IO_FLAGS2_MMAP_WINDOW)
+    {
+      size_t left = fp->_IO_read_end - fp->_IO_read_ptr;
+      if (_IO_file_mmap_window_move (fp) != 0)
+	/* We punted to the regular file functions.  */
+	return _IO_WUNDERFLOW (fp);
+      if ((size_t) (fp->_IO_read_end - fp->_IO_read_ptr) > left)
+	goto convert;
+    }
+
   /* There is some garbage at the end of the file.  */
   __set_errno (EILSEQ);
   fp->_flags |= _IO_ERR_SEEN;
@@ -901,6 +919,9 @@ _IO_wfile_seekoff (FILE *fp, off64_t offset, int dir, int mode)
       count = _IO_SYSREAD (fp, fp->_IO_buf_base,
 			   (must_be_exact
 			    ? delta : fp->_IO_buf_end - fp->_IO_buf_base));
+      struct __stdio_stats *stats = _IO_stats (fp);
+      if (stats != NULL && count > 0)
+	stats->bytes_read_buffered += count;
       if (count < delta)
 	{
 	  /* We weren't allowed to read, but try to seek the remainder. */
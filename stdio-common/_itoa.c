@@ -175,7 +175,8 @@ _itoa_word (_ITOA_WORD_TYPE value, char *buflim,
       while ((value /= Base) != 0);					      \
       break
 
-      SPECIAL (10);
+    case 10:
+      return _itoa_word_decimal (value, buflim);
       SPECIAL (16);
       SPECIAL (8);
     default:
@@ -22,3 +22,16 @@
 const char _itoa_lower_digits[36]
 	= "0123456789abcdefghijklmnopqrstuvwxyz";
 libc_hidden_data_def (_itoa_lower_digits)
+
+/* The numbers 0 to 99 as pairs of decimal digits.  */
+const char _itoa_decimal_pairs[200] attribute_hidden
+	= "00010203040506070809"
+	  "10111213141516171819"
+	  "20212223242526272829"
+	  "30313233343536373839"
+	  "40414243444546474849"
+	  "50515253545556575859"
+	  "60616263646566676869"
+	  "70717273747576777879"
+	  "80818283848586878889"
+	  "90919293949596979899";
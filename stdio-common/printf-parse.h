@@ -107,6 +107,24 @@ extern size_t __parse_one_specwc (const unsigned int *format, size_t posn,
 
 
 
+#ifndef COMPILE_WPRINTF
+/* Return the cached parse of the format string FORMAT, which starts
+   with its first conversion, and store the number of specs and
+   arguments in *NSPECS and *NARGS.  Return NULL if FORMAT is not in
+   the cache of the calling thread.  */
+extern const struct printf_spec *__printf_spec_cache_lookup
+  (const unsigned char *format, size_t *nspecs, size_t *nargs)
+  attribute_hidden;
+
+/* Add the NSPECS specs parsed from FORMAT, which consume NARGS
+   arguments, to the cache of the calling thread if it is enabled.  */
+extern void __printf_spec_cache_insert (const unsigned char *format,
+					const struct printf_spec *specs,
+					size_t nspecs, size_t nargs)
+  attribute_hidden;
+#endif
+
+
 /* This variable is defined in reg-modifier.c.  */
 struct printf_modifier_record;
 extern struct printf_modifier_record **__printf_modifier_table
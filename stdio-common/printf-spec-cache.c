@@ -0,0 +1,180 @@
+/* Per-thread cache of parsed printf format strings.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Format strings with positional arguments are parsed completely
+   before any argument is fetched, which costs a call to
+   __parse_one_specmb per conversion on every printf call.  Programs
+   which print the same (translated) formats over and over can enable
+   this cache with the glibc.stdio.printf_cache_size tunable.  It maps
+   the address of a format string to the parsed spec list, so that the
+   parse is skipped for repeated formats.
+
+   The cache is direct-mapped and private to each thread, so no
+   locking is needed.  Each entry keeps a copy of the format string,
+   which is compared against the current format on lookup: a hit thus
+   requires the same address and the same contents, and the pointers
+   into the format string stored in the specs remain valid.  The parse
+   depends on registered printf specifiers and modifiers, so the cache
+   is bypassed once any have been registered.  */
+
+#include <limits.h>
+#include <printf.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tls-internal.h>
+
+#define UCHAR_T		unsigned char
+#define DONT_NEED_READ_INT
+#include "printf-parse.h"
+
+#define TUNABLE_NAMESPACE stdio
+#include <elf/dl-tunables.h>
+
+/* Formats with more conversions or longer than this are not cached,
+   to bound the size of an entry.  */
+#define MAX_SPECS 64
+#define MAX_LENGTH 1024
+
+/* Upper limit for the number of entries of a cache.  */
+#define MAX_ENTRIES_BITS 10
+#define MAX_ENTRIES (1 << MAX_ENTRIES_BITS)
+
+struct printf_spec_cache_entry
+{
+  /* Address of the format string, starting at its first conversion.  */
+  const unsigned char *format;
+  /* Length of the format string, without the terminating null byte.  */
+  size_t length;
+  size_t nspecs;
+  /* Number of arguments consumed by the format.  */
+  size_t nargs;
+  /* NSPECS parsed specs, followed by a copy of the format string.  */
+  struct printf_spec specs[];
+};
+
+struct printf_spec_cache
+{
+  /* The number of entries minus one.  */
+  size_t mask;
+  struct printf_spec_cache_entry *entries[];
+};
+
+static inline bool
+cache_usable (void)
+{
+  return __printf_function_table == NULL && __printf_modifier_table == NULL;
+}
+
+static inline size_t
+cache_slot (const struct printf_spec_cache *cache,
+	    const unsigned char *format)
+{
+  /* Format strings are packed next to each other in read-only data,
+     so use the well-mixed top bits of a multiplicative hash of the
+     address.  */
+  uintptr_t hash = (uintptr_t) format * (uintptr_t) 0x9e3779b97f4a7c15ULL;
+  return (hash >> (sizeof (hash) * CHAR_BIT - MAX_ENTRIES_BITS)) & cache->mask;
+}
+
+static inline const unsigned char *
+entry_format_copy (const struct printf_spec_cache_entry *entry)
+{
+  return (const unsigned char *) &entry->specs[entry->nspecs];
+}
+
+const struct printf_spec *
+__printf_spec_cache_lookup (const unsigned char *format, size_t *nspecs,
+			    size_t *nargs)
+{
+  struct printf_spec_cache *cache
+    = __glibc_tls_internal ()->printf_spec_cache;
+  if (cache == NULL || !cache_usable ())
+    return NULL;
+
+  struct printf_spec_cache_entry *entry
+    = cache->entries[cache_slot (cache, format)];
+  if (entry == NULL || entry->format != format
+      || strncmp ((const char *) format,
+		  (const char *) entry_format_copy (entry),
+		  entry->length) != 0
+      || format[entry->length] != '\0')
+    return NULL;
+
+  *nspecs = entry->nspecs;
+  *nargs = entry->nargs;
+  return entry->specs;
+}
+
+void
+__printf_spec_cache_insert (const unsigned char *format,
+			    const struct printf_spec *specs, size_t nspecs,
+			    size_t nargs)
+{
+  struct tls_internal_t *tls = __glibc_tls_internal ();
+  struct printf_spec_cache *cache = tls->printf_spec_cache;
+  if (cache == NULL)
+    {
+      size_t size = TUNABLE_GET (printf_cache_size, size_t, NULL);
+      if (size == 0)
+	return;
+      size_t entries = 1;
+      while (entries < size && entries < MAX_ENTRIES)
+	entries *= 2;
+      cache = calloc (1, sizeof (*cache)
+			 + entries * sizeof (cache->entries[0]));
+      if (cache == NULL)
+	return;
+      cache->mask = entries - 1;
+      tls->printf_spec_cache = cache;
+    }
+
+  if (nspecs > MAX_SPECS || !cache_usable ())
+    return;
+  size_t length = strnlen ((const char *) format, MAX_LENGTH);
+  if (length == MAX_LENGTH)
+    return;
+
+  struct printf_spec_cache_entry *entry
+    = malloc (sizeof (*entry) + nspecs * sizeof (entry->specs[0])
+	      + length + 1);
+  if (entry == NULL)
+    return;
+  entry->format = format;
+  entry->length = length;
+  entry->nspecs = nspecs;
+  entry->nargs = nargs;
+  memcpy (entry->specs, specs, nspecs * sizeof (entry->specs[0]));
+  memcpy ((unsigned char *) entry_format_copy (entry), format, length + 1);
+
+  /* Replace the previous occupant of the slot.  */
+  size_t slot = cache_slot (cache, format);
+  free (cache->entries[slot]);
+  cache->entries[slot] = entry;
+}
+
+void
+__printf_spec_cache_free (struct printf_spec_cache *cache)
+{
+  if (cache == NULL)
+    return;
+  for (size_t i = 0; i <= cache->mask; i++)
+    free (cache->entries[i]);
+  free (cache);
+}
@@ -127,6 +127,433 @@ hack_digit (struct hack_digit_param *p)
   return '0' + hi;
 }
 
+/* Write the digits in [WSTARTP, WCP) to BUF, adding the sign, the
+   padding requested by INFO, and thousands separators between the
+   first INTDIG_NO digits if grouping is enabled.  */
+static void
+__printf_fp_buffer_write (struct __printf_buffer *buf, locale_t loc,
+			  int lc_category, char thousands_sep,
+			  const struct printf_info *info, int is_neg,
+			  const char *wstartp, const char *wcp, int intdig_no)
+{
+  int width = info->width;
+
+  struct grouping_iterator iter;
+  if (thousands_sep != '\0' && info->group)
+    __grouping_iterator_init (&iter, lc_category, loc, intdig_no);
+  else
+    iter.separators = 0;
+
+  /* Compute number of characters which must be filled with the padding
+     character.  */
+  if (is_neg || info->showsign || info->space)
+    --width;
+  /* To count bytes, we would have to use __translated_number_width
+     for info->i18n && !info->wide.  See bug 28943.  */
+  width -= wcp - wstartp;
+  /* For counting bytes, we would have to multiply by
+     thousands_sep_length.  */
+  width -= iter.separators;
+
+  if (!info->left && info->pad != '0')
+    __printf_buffer_pad (buf, info->pad, width);
+
+  if (is_neg)
+    __printf_buffer_putc (buf, '-');
+  else if (info->showsign)
+    __printf_buffer_putc (buf, '+');
+  else if (info->space)
+    __printf_buffer_putc (buf, ' ');
+
+  if (!info->left && info->pad == '0')
+    __printf_buffer_pad (buf, '0', width);
+
+  if (iter.separators > 0)
+    {
+      const char *cp = wstartp;
+      for (int i = 0; i < intdig_no; ++i)
+	{
+	  if (__grouping_iterator_next (&iter))
+	    __printf_buffer_putc (buf, thousands_sep);
+	  __printf_buffer_putc (buf, *cp);
+	  ++cp;
+	}
+      __printf_buffer_write (buf, cp, wcp - cp);
+    }
+  else
+    __printf_buffer_write (buf, wstartp, wcp - wstartp);
+
+  if (info->left)
+    __printf_buffer_pad (buf, info->pad, width);
+}
+
+#ifdef __SIZEOF_INT128__
+/* Conversions of binary64 values are first attempted with 128-bit
+   integer arithmetic.  This covers the common case of a small precision
+   and a value of moderate magnitude, where the decimal digits and the
+   bits below the rounding position all fit into 128 bits.  The result
+   is exact and rounded in the same way as the multi-precision code, so
+   the output is identical.  Everything else (large precisions, very
+   large or very small values, long double and _Float128) uses the
+   general code below.  */
+# define PRINTF_FP_FAST 1
+
+typedef unsigned __int128 fp_fast_uint;
+
+/* Largest precision handled by the fast path.  At most 37 digits are
+   needed for %e, so that 10 to the power of the digit count fits.  */
+# define FP_FAST_MAX_PREC 36
+
+/* Enough for the integer digits of any fp_fast_uint, the radix
+   character, FP_FAST_MAX_PREC fractional digits and an exponent.  */
+# define FP_FAST_BUFSIZE 96
+
+static const uint64_t fp_fast_pow10_tab[] =
+  {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+    100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL,
+    10000000000000000000ULL
+  };
+
+/* Return 10^N, for 0 <= N <= 38.  */
+static inline fp_fast_uint
+fp_fast_pow10 (int n)
+{
+  if (n < 20)
+    return fp_fast_pow10_tab[n];
+  return (fp_fast_uint) fp_fast_pow10_tab[19] * fp_fast_pow10_tab[n - 19];
+}
+
+/* Return the number of significant bits in X.  */
+static inline int
+fp_fast_bits (fp_fast_uint x)
+{
+  uint64_t hi = x >> 64;
+  if (hi != 0)
+    return 128 - __builtin_clzll (hi);
+  if ((uint64_t) x != 0)
+    return 64 - __builtin_clzll ((uint64_t) x);
+  return 0;
+}
+
+/* The value M * 2^E * 10^T, split into its integer part Q and the
+   information needed for rounding it: whether the fractional part is
+   at least one half, and whether there are nonzero bits below that.  */
+struct fp_fast_scaled
+{
+  fp_fast_uint q;
+  bool half_bit;
+  bool more_bits;
+};
+
+/* Compute M * 2^E * 10^T into *R.  Return false if the computation does
+   not fit into 128 bits.  */
+static bool
+fp_fast_scale (uint64_t m, int e, int t, struct fp_fast_scaled *r)
+{
+  fp_fast_uint n = m;
+  fp_fast_uint d;
+
+  if (t > 38 || t < -38)
+    return false;
+
+  if (t >= 0)
+    {
+      fp_fast_uint p = fp_fast_pow10 (t);
+      if (fp_fast_bits (n) + fp_fast_bits (p) > 128)
+	return false;
+      n *= p;
+      if (e >= 0)
+	{
+	  if (fp_fast_bits (n) + e > 128)
+	    return false;
+	  r->q = n << e;
+	  r->half_bit = r->more_bits = false;
+	  return true;
+	}
+
+      /* Divide by 2^-E.  */
+      int s = -e;
+      if (s >= 128)
+	{
+	  r->q = 0;
+	  r->half_bit = s == 128 && (n >> 127) != 0;
+	  r->more_bits = r->half_bit ? (n << 1) != 0 : n != 0;
+	}
+      else
+	{
+	  fp_fast_uint rem = n & (((fp_fast_uint) 1 << s) - 1);
+	  fp_fast_uint half = (fp_fast_uint) 1 << (s - 1);
+	  r->q = n >> s;
+	  r->half_bit = (rem & half) != 0;
+	  r->more_bits = (rem & (half - 1)) != 0;
+	}
+      return true;
+    }
+
+  /* Divide by 10^-T, and by 2^-E if E is negative.  */
+  d = fp_fast_pow10 (-t);
+  if (e >= 0)
+    {
+      if (fp_fast_bits (n) + e > 128)
+	return false;
+      n <<= e;
+    }
+  else
+    {
+      if (fp_fast_bits (d) - e > 128)
+	return false;
+      d <<= -e;
+    }
+  /* D is even because T is negative.  */
+  fp_fast_uint rem = n % d;
+  fp_fast_uint half = d >> 1;
+  r->q = n / d;
+  r->half_bit = rem >= half;
+  r->more_bits = r->half_bit ? rem > half : rem != 0;
+  return true;
+}
+
+/* Round the value in R to an integer.  */
+static inline fp_fast_uint
+fp_fast_round (const struct fp_fast_scaled *r, int is_neg, int mode)
+{
+  return r->q + round_away (is_neg, r->q & 1, r->half_bit, r->more_bits,
+			    mode);
+}
+
+/* Round M * 2^E (which is not zero) to NDIG significant decimal
+   digits.  Store the digits as an integer in *Q and the decimal
+   exponent of the leading digit in *EXP10.  *CARRY is set if rounding
+   increased the exponent.  */
+static bool
+fp_fast_round_digits (uint64_t m, int e, int ndig, int is_neg, int mode,
+		      fp_fast_uint *q, int *exp10, bool *carry)
+{
+  struct fp_fast_scaled r;
+
+  /* M * 2^E is in [2^(B-1), 2^B).  78913 / 2^18 approximates log10(2),
+     so X is the decimal exponent, or off by one.  */
+  int b = 64 - __builtin_clzll (m) + e;
+  int x = ((b - 1) * 78913) >> 18;
+
+  if (!fp_fast_scale (m, e, ndig - 1 - x, &r))
+    return false;
+  if (r.q >= fp_fast_pow10 (ndig))
+    ++x;
+  else if (r.q < fp_fast_pow10 (ndig - 1))
+    --x;
+  else
+    goto done;
+  if (!fp_fast_scale (m, e, ndig - 1 - x, &r))
+    return false;
+
+ done:
+  *q = fp_fast_round (&r, is_neg, mode);
+  *carry = *q == fp_fast_pow10 (ndig);
+  if (*carry)
+    {
+      /* All digits were nines.  */
+      *q = fp_fast_pow10 (ndig - 1);
+      ++x;
+    }
+  *exp10 = x;
+  return true;
+}
+
+/* Write the decimal digits of Q, padded with zeros to at least MIN
+   digits, to the characters just before END.  Return the start of the
+   digits.  */
+static char *
+fp_fast_digits (fp_fast_uint q, char *end, int min)
+{
+  char *cp = end;
+
+  while (q > UINT64_MAX)
+    {
+      uint64_t lo = q % fp_fast_pow10_tab[19];
+      q /= fp_fast_pow10_tab[19];
+      for (int i = 0; i < 19; ++i)
+	{
+	  *--cp = '0' + lo % 10;
+	  lo /= 10;
+	}
+    }
+  uint64_t v = q;
+  do
+    {
+      *--cp = '0' + v % 10;
+      v /= 10;
+    }
+  while (v != 0);
+  while (end - cp < min)
+    *--cp = '0';
+  return cp;
+}
+
+/* Try to format VALUE according to INFO using 128-bit arithmetic.
+   Return false if the value or precision is outside the range
+   supported, in which case nothing has been written to BUF.  */
+static bool
+__printf_fp_fast (struct __printf_buffer *buf, locale_t loc,
+		  int lc_category, char thousands_sep, char decimal,
+		  const struct printf_info *info, double value, int is_neg)
+{
+  char spec = _tolower (info->spec);
+  int prec = info->prec < 0 ? 6 : info->prec;
+  char work[FP_FAST_BUFSIZE];
+  char digits[FP_FAST_BUFSIZE];
+  char *dend = digits + sizeof (digits);
+  char *wcp = work;
+  int intdig_no;
+  fp_fast_uint q;
+  int exp10;
+  bool carry = false;
+
+  if (prec > FP_FAST_MAX_PREC)
+    return false;
+
+  /* Decompose VALUE into M * 2^E, with M odd unless it is zero.  */
+  union ieee754_double u = { .d = value };
+  uint64_t m = ((uint64_t) u.ieee.mantissa0 << 32) | u.ieee.mantissa1;
+  int e;
+  if (u.ieee.exponent == 0)
+    e = 1 - IEEE754_DOUBLE_BIAS - (DBL_MANT_DIG - 1);
+  else
+    {
+      m |= 1ULL << (DBL_MANT_DIG - 1);
+      e = u.ieee.exponent - IEEE754_DOUBLE_BIAS - (DBL_MANT_DIG - 1);
+    }
+  if (m != 0)
+    {
+      int tz = __builtin_ctzll (m);
+      m >>= tz;
+      e += tz;
+    }
+
+  int rounding_mode = get_rounding_mode ();
+
+  if (spec == 'f')
+    {
+      struct fp_fast_scaled r;
+      if (m == 0)
+	q = 0;
+      else if (fp_fast_scale (m, e, prec, &r))
+	q = fp_fast_round (&r, is_neg, rounding_mode);
+      else
+	return false;
+
+      char *dp = fp_fast_digits (q, dend, prec + 1);
+      intdig_no = dend - dp - prec;
+      wcp = __mempcpy (wcp, dp, intdig_no);
+      if (prec > 0 || info->alt)
+	*wcp++ = decimal;
+      wcp = __mempcpy (wcp, dp + intdig_no, prec);
+    }
+  else
+    {
+      /* The number of significant digits, and whether trailing zeros
+	 in the fraction are removed.  */
+      int ndig;
+      bool strip;
+      bool use_exp;
+      if (spec == 'e')
+	{
+	  ndig = prec + 1;
+	  strip = false;
+	}
+      else
+	{
+	  ndig = prec == 0 ? 1 : prec;
+	  strip = !info->alt;
+	}
+
+      if (m == 0)
+	{
+	  q = 0;
+	  exp10 = 0;
+	}
+      else if (!fp_fast_round_digits (m, e, ndig, is_neg, rounding_mode,
+				      &q, &exp10, &carry))
+	return false;
+
+      /* If %g selected %f notation and rounding produced an additional
+	 integer digit, switching to %e notation, the general code removes
+	 the trailing zeros even with the '#' flag.  */
+      if (spec == 'g' && carry && exp10 == ndig)
+	strip = true;
+
+      char *dp = fp_fast_digits (q, dend, ndig);
+      if (strip)
+	while (dend > dp + 1 && dend[-1] == '0')
+	  --dend;
+
+      if (spec == 'e')
+	use_exp = true;
+      else
+	use_exp = exp10 < -4 || exp10 >= ndig;
+
+      if (use_exp)
+	{
+	  intdig_no = 1;
+	  *wcp++ = *dp++;
+	  if (dp < dend || info->alt)
+	    *wcp++ = decimal;
+	  wcp = __mempcpy (wcp, dp, dend - dp);
+
+	  *wcp++ = isupper (info->spec) ? 'E' : 'e';
+	  if (exp10 < 0)
+	    {
+	      *wcp++ = '-';
+	      exp10 = -exp10;
+	    }
+	  else
+	    *wcp++ = '+';
+	  if (exp10 >= 100)
+	    {
+	      *wcp++ = '0' + exp10 / 100;
+	      exp10 %= 100;
+	    }
+	  *wcp++ = '0' + exp10 / 10;
+	  *wcp++ = '0' + exp10 % 10;
+	}
+      else if (exp10 >= 0)
+	{
+	  /* %g with a value of at least 1.  Integer digits which have been
+	     removed as trailing zeros are restored.  */
+	  intdig_no = exp10 + 1;
+	  int n = MIN (intdig_no, dend - dp);
+	  wcp = __mempcpy (wcp, dp, n);
+	  memset (wcp, '0', intdig_no - n);
+	  wcp += intdig_no - n;
+	  dp += n;
+	  if (dp < dend || info->alt)
+	    *wcp++ = decimal;
+	  wcp = __mempcpy (wcp, dp, dend - dp);
+	}
+      else
+	{
+	  /* %g with a value less than 1.  */
+	  intdig_no = 0;
+	  *wcp++ = '0';
+	  *wcp++ = decimal;
+	  memset (wcp, '0', -exp10 - 1);
+	  wcp += -exp10 - 1;
+	  wcp = __mempcpy (wcp, dp, dend - dp);
+	}
+    }
+
+  __printf_fp_buffer_write (buf, loc, lc_category, thousands_sep, info,
+			    is_neg, work, wcp, intdig_no);
+  return true;
+}
+#else
+# define PRINTF_FP_FAST 0
+#endif
+
 /* Version that performs grouping (if INFO->group && THOUSANDS_SEP != 0),
    but not i18n digit translation.
 
@@ -257,6 +684,23 @@ __printf_fp_buffer_1 (struct __printf_buffer *buf, locale_t loc,
       return;
     }
 
+#if PRINTF_FP_FAST
+  {
+    bool is_double = true;
+# if __HAVE_DISTINCT_FLOAT128
+    if (info->is_binary128)
+      is_double = false;
+# endif
+# ifndef __NO_LONG_DOUBLE_MATH
+    if (info->is_long_double && sizeof (long double) > sizeof (double))
+      is_double = false;
+# endif
+    if (is_double
+	&& __printf_fp_fast (buf, loc, lc_category, thousands_sep, decimal,
+			     info, fpnum.dbl, is_neg))
+      return;
+  }
+#endif
 
   /* We need three multiprecision variables.  Now that we have the p.exponent
      of the number we can allocate the needed memory.  It would be more
@@ -662,7 +1106,6 @@ __printf_fp_buffer_1 (struct __printf_buffer *buf, locale_t loc,
     }
 
   {
-    int width = info->width;
     char *wstartp, *wcp;
     size_t chars_needed;
     int expscale;
@@ -976,53 +1419,8 @@ __printf_fp_buffer_1 (struct __printf_buffer *buf, locale_t loc,
 	  }
       }
 
-    struct grouping_iterator iter;
-    if (thousands_sep != '\0' && info->group)
-      __grouping_iterator_init (&iter, lc_category, loc, intdig_no);
-    else
-      iter.separators = 0;
-
-    /* Compute number of characters which must be filled with the padding
-       character.  */
-    if (is_neg || info->showsign || info->space)
-      --width;
-    /* To count bytes, we would have to use __translated_number_width
-       for info->i18n && !info->wide.  See bug 28943.  */
-    width -= wcp - wstartp;
-    /* For counting bytes, we would have to multiply by
-       thousands_sep_length.  */
-    width -= iter.separators;
-
-    if (!info->left && info->pad != '0')
-      __printf_buffer_pad (buf, info->pad, width);
-
-    if (is_neg)
-      __printf_buffer_putc (buf, '-');
-    else if (info->showsign)
-      __printf_buffer_putc (buf, '+');
-    else if (info->space)
-      __printf_buffer_putc (buf, ' ');
-
-    if (!info->left && info->pad == '0')
-      __printf_buffer_pad (buf, '0', width);
-
-    if (iter.separators > 0)
-      {
-	char *cp = wstartp;
-	for (int i = 0; i < intdig_no; ++i)
-	  {
-	    if (__grouping_iterator_next (&iter))
-	      __printf_buffer_putc (buf, thousands_sep);
-	    __printf_buffer_putc (buf, *cp);
-	    ++cp;
-	  }
-	__printf_buffer_write (buf, cp, wcp - cp);
-      }
-    else
-      __printf_buffer_write (buf, wstartp, wcp - wstartp);
-
-    if (info->left)
-      __printf_buffer_pad (buf, info->pad, width);
+    __printf_fp_buffer_write (buf, loc, lc_category, thousands_sep, info,
+			      is_neg, wstartp, wcp, intdig_no);
   }
 
   if (buffer_malloced)
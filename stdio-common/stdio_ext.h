@@ -38,6 +38,28 @@ enum
 #define FSETLOCKING_BYCALLER	FSETLOCKING_BYCALLER
 };
 
+/* Statistics of a stream, filled in by __fstats.  */
+struct __stdio_stats
+{
+  /* Number of read, write and seek system calls.  */
+  __uint64_t read_calls;
+  __uint64_t write_calls;
+  __uint64_t seek_calls;
+  /* Bytes transferred by the read and write system calls.  */
+  __uint64_t bytes_read;
+  __uint64_t bytes_written;
+  /* The part of these bytes which passed through the stream buffer.  */
+  __uint64_t bytes_read_buffered;
+  __uint64_t bytes_written_buffered;
+  /* Number of times the buffer was written out.  */
+  __uint64_t flushes;
+  /* Number of allocations of the buffer, including its replacement
+     by a larger one.  */
+  __uint64_t buffer_allocations;
+  /* Time spent in the system calls above, in nanoseconds.  */
+  __uint64_t blocked_ns;
+};
+
 
 __BEGIN_DECLS
 
@@ -81,6 +103,11 @@ extern void _flushlbf (void);
 /* Set locking status of stream FP to TYPE.  */
 extern int __fsetlocking (FILE *__fp, int __type) __THROW;
 
+/* Store the statistics of the stream FP in *STATS.  They are only
+   collected if enabled with the glibc.stdio.stream_stats tunable.
+   Return 0 on success, or -1 if there are no statistics.  */
+extern int __fstats (FILE *__fp, struct __stdio_stats *__stats) __THROW;
+
 __END_DECLS
 
 #endif	/* stdio_ext.h */
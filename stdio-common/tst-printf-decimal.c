@@ -0,0 +1,132 @@
+/* Test printf conversions of integers without flags, width or precision.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* These conversions write the digits directly into the output buffer
+   if it has enough room, so check values around each power of ten,
+   with output buffers of all sizes.  */
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <support/check.h>
+
+/* Convert VALUE to decimal in BUF the slow way.  */
+static void
+reference (char *buf, unsigned long int value, bool negative)
+{
+  char tmp[32];
+  char *p = tmp + sizeof (tmp);
+  *--p = '\0';
+  do
+    *--p = '0' + value % 10;
+  while ((value /= 10) != 0);
+  if (negative)
+    *--p = '-';
+  strcpy (buf, p);
+}
+
+static void
+check_value (unsigned long int value)
+{
+  char expected[64];
+  char buf[64];
+
+  reference (expected, value, false);
+  TEST_COMPARE (sprintf (buf, "%lu", value), strlen (expected));
+  TEST_COMPARE_STRING (buf, expected);
+
+  /* Truncated output, which does not leave room for all digits.  */
+  for (size_t size = 0; size <= strlen (expected) + 1; size++)
+    {
+      memset (buf, '#', sizeof (buf));
+      TEST_COMPARE (snprintf (buf, size, "%lu", value), strlen (expected));
+      if (size > 0)
+	{
+	  TEST_COMPARE_BLOB (buf, size - 1, expected, size - 1);
+	  TEST_COMPARE (buf[size - 1], '\0');
+	}
+      TEST_COMPARE (buf[size], '#');
+    }
+
+  /* Several conversions in a row, and the signed variants.  */
+  char expected2[128];
+  TEST_COMPARE (sprintf (buf, "<%lu%lu>", value, value),
+		2 * strlen (expected) + 2);
+  sprintf (expected2, "<%s%s>", expected, expected);
+  TEST_COMPARE_STRING (buf, expected2);
+
+  if (value <= LONG_MAX)
+    {
+      TEST_COMPARE (sprintf (buf, "%ld", (long int) value),
+		    strlen (expected));
+      TEST_COMPARE_STRING (buf, expected);
+      reference (expected, value, true);
+      TEST_COMPARE (sprintf (buf, "%ld", -(long int) value),
+		    value == 0 ? 1 : strlen (expected));
+      TEST_COMPARE_STRING (buf, value == 0 ? "0" : expected);
+    }
+  if (value <= UINT_MAX)
+    {
+      reference (expected, value, false);
+      TEST_COMPARE (sprintf (buf, "%u", (unsigned int) value),
+		    strlen (expected));
+      TEST_COMPARE_STRING (buf, expected);
+    }
+}
+
+static int
+do_test (void)
+{
+  unsigned long int power = 1;
+  while (true)
+    {
+      check_value (power - 1);
+      check_value (power);
+      check_value (power + 1);
+      if (power > ULONG_MAX / 10)
+	break;
+      power *= 10;
+    }
+  for (unsigned int bit = 0; bit < sizeof (long int) * CHAR_BIT; bit++)
+    {
+      check_value (1UL << bit);
+      check_value ((1UL << bit) - 1);
+    }
+  check_value (ULONG_MAX);
+  check_value (LONG_MAX);
+
+  char buf[64];
+  sprintf (buf, "%ld", LONG_MIN);
+  char expected[64];
+  reference (expected, -(unsigned long int) LONG_MIN, true);
+  TEST_COMPARE_STRING (buf, expected);
+
+  /* Conversions with flags, width or precision take the general
+     path.  */
+  TEST_COMPARE (sprintf (buf, "%5d|%-5d|%.3d|%+d|% d|%#x|%05d", 12, 12, 12,
+			 12, 12, 255, -12), 34);
+  TEST_COMPARE_STRING (buf, "   12|12   |012|+12| 12|0xff|-0012");
+  TEST_COMPARE (sprintf (buf, "%x|%X|%o|%zu|%.0d|", 0xabcU, 0xabcU, 8U,
+			 (size_t) 42, 0), 15);
+  TEST_COMPARE_STRING (buf, "abc|ABC|10|42||");
+
+  return 0;
+}
+
+#include <support/test-driver.c>
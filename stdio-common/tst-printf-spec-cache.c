@@ -0,0 +1,152 @@
+/* Test the per-thread cache of parsed positional printf formats.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* The test runs with glibc.stdio.printf_cache_size=4, so that the
+   formats below compete for the slots of the cache.  */
+
+#include <array_length.h>
+#include <printf.h>
+#include <stdio.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/xthread.h>
+
+static const struct
+{
+  const char *format;
+  const char *expected;
+} formats[] =
+  {
+    { "%2$d %1$s", "2 one" },
+    { "[%1$s|%2$d|%3$s]", "[one|2|three]" },
+    { "%3$s%2$d%1$s", "three2one" },
+    { "%2$*2$d|%1$.*2$s", " 2|on" },
+    { "%2$5d:%1$-5s:", "    2:one  :" },
+    { "%1$s %1$s %2$#x", "one one 0x2" },
+    { "x%2$d%%y", "x2%y" },
+    { "%3$.3s-%1$.1s", "thr-o" },
+  };
+
+static void
+check_formats (void)
+{
+  char buf[64];
+  for (size_t i = 0; i < array_length (formats); i++)
+    {
+      int ret = sprintf (buf, formats[i].format, "one", 2, "three");
+      TEST_COMPARE (ret, strlen (formats[i].expected));
+      TEST_COMPARE_STRING (buf, formats[i].expected);
+    }
+}
+
+static void *
+thread_func (void *closure)
+{
+  for (int i = 0; i < 1000; i++)
+    check_formats ();
+  return NULL;
+}
+
+/* A writable format string whose contents change between calls, at
+   the same address.  */
+static void
+check_modified_format (void)
+{
+  char format[32];
+  char buf[64];
+
+  for (int i = 0; i < 3; i++)
+    {
+      strcpy (format, "%2$d %1$d");
+      TEST_COMPARE (sprintf (buf, format, 1, 2), 3);
+      TEST_COMPARE_STRING (buf, "2 1");
+
+      strcpy (format, "%2$d+%1$d");
+      TEST_COMPARE (sprintf (buf, format, 1, 2), 3);
+      TEST_COMPARE_STRING (buf, "2+1");
+
+      strcpy (format, "%2$d+%1$d!");
+      TEST_COMPARE (sprintf (buf, format, 1, 2), 4);
+      TEST_COMPARE_STRING (buf, "2+1!");
+
+      strcpy (format, "%2$d");
+      TEST_COMPARE (sprintf (buf, format, 1, 2), 1);
+      TEST_COMPARE_STRING (buf, "2");
+
+      strcpy (format, "%1$s%2$s");
+      TEST_COMPARE (sprintf (buf, format, "a", "b"), 2);
+      TEST_COMPARE_STRING (buf, "ab");
+    }
+}
+
+static int
+y_printf (FILE *fp, const struct printf_info *info, const void *const *args)
+{
+  return fprintf (fp, "<%g>", **(const double **) args);
+}
+
+static int
+y_arginfo (const struct printf_info *info, size_t n, int *argtypes,
+	   int *size)
+{
+  if (n > 0)
+    argtypes[0] = PA_DOUBLE;
+  return 1;
+}
+
+/* The parse depends on the registered specifiers, so formats cached
+   before the registration must be parsed again.  */
+static void
+check_register (void)
+{
+  static const char format[] = "%1$s:%2$Y|%3$d";
+  char buf[64];
+
+  /* The unknown conversion consumes no argument.  */
+  for (int i = 0; i < 3; i++)
+    {
+      TEST_COMPARE (sprintf (buf, format, "a", 5, 7), 6);
+      TEST_COMPARE_STRING (buf, "a:%Y|7");
+    }
+
+  TEST_COMPARE (register_printf_specifier ('Y', y_printf, y_arginfo), 0);
+  for (int i = 0; i < 3; i++)
+    {
+      TEST_COMPARE (sprintf (buf, format, "a", 2.5, 7), 9);
+      TEST_COMPARE_STRING (buf, "a:<2.5>|7");
+    }
+}
+
+static int
+do_test (void)
+{
+  for (int i = 0; i < 10; i++)
+    check_formats ();
+
+  pthread_t threads[4];
+  for (size_t i = 0; i < array_length (threads); i++)
+    threads[i] = xpthread_create (NULL, thread_func, NULL);
+  for (size_t i = 0; i < array_length (threads); i++)
+    xpthread_join (threads[i]);
+
+  check_modified_format ();
+  check_register ();
+  return 0;
+}
+
+#include <support/test-driver.c>
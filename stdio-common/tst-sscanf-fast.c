@@ -0,0 +1,191 @@
+/* Test sscanf with formats handled by the string scanning fast path.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Formats which only use %d, %u, %x, %s, %[...] and %n are scanned
+   directly on the input string.  The results must not differ from the
+   general code, in particular for input and matching failures.  */
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+
+static void
+check_numbers (void)
+{
+  int i1 = -1, i2 = -1, n = -1;
+  unsigned int u = 0;
+  long int l = 0;
+  long long int ll = 0;
+  short int h = 0;
+  signed char hh = 0;
+  size_t z = 0;
+
+  TEST_COMPARE (sscanf ("  42 -17", "%d%d%n", &i1, &i2, &n), 2);
+  TEST_COMPARE (i1, 42);
+  TEST_COMPARE (i2, -17);
+  TEST_COMPARE (n, 8);
+
+  TEST_COMPARE (sscanf ("+7,0x1F", "%u,%x", &u, &i1), 2);
+  TEST_COMPARE (u, 7);
+  TEST_COMPARE (i1, 0x1f);
+
+  /* The 0x prefix is consumed even without a following digit.  */
+  TEST_COMPARE (sscanf ("0xg", "%x%n", &i1, &n), 1);
+  TEST_COMPARE (i1, 0);
+  TEST_COMPARE (n, 2);
+  TEST_COMPARE (sscanf ("-0x", "%X%n", &i1, &n), 1);
+  TEST_COMPARE (i1, 0);
+  TEST_COMPARE (n, 3);
+  /* But not for decimal conversions.  */
+  TEST_COMPARE (sscanf ("0x5", "%d%n", &i1, &n), 1);
+  TEST_COMPARE (i1, 0);
+  TEST_COMPARE (n, 1);
+
+  TEST_COMPARE (sscanf ("-9223372036854775808 1234567890 70000 300 77",
+			"%lld %ld %hd %hhd %zu", &ll, &l, &h, &hh, &z), 5);
+  TEST_COMPARE (ll, LLONG_MIN);
+  TEST_COMPARE (l, 1234567890L);
+  TEST_COMPARE (h, (short int) 70000);
+  TEST_COMPARE (hh, (signed char) 300);
+  TEST_COMPARE (z, 77);
+
+  /* Out of range values saturate like strtol.  */
+  TEST_COMPARE (sscanf ("99999999999999999999", "%ld", &l), 1);
+  TEST_COMPARE (l, LONG_MAX);
+
+  /* Suppressed assignments are not counted.  */
+  i1 = -1;
+  TEST_COMPARE (sscanf ("1 2", "%*d %d", &i1), 1);
+  TEST_COMPARE (i1, 2);
+}
+
+static void
+check_strings (void)
+{
+  char s1[32], s2[32];
+  int n = -1;
+
+  TEST_COMPARE (sscanf ("  hello world", "%s %s%n", s1, s2, &n), 2);
+  TEST_COMPARE_STRING (s1, "hello");
+  TEST_COMPARE_STRING (s2, "world");
+  TEST_COMPARE (n, 13);
+
+  TEST_COMPARE (sscanf ("abcdef", "%3s%s", s1, s2), 2);
+  TEST_COMPARE_STRING (s1, "abc");
+  TEST_COMPARE_STRING (s2, "def");
+
+  TEST_COMPARE (sscanf ("key=value;rest", "%[^=]=%[^;];%n", s1, s2, &n), 2);
+  TEST_COMPARE_STRING (s1, "key");
+  TEST_COMPARE_STRING (s2, "value");
+  TEST_COMPARE (n, 10);
+
+  /* A leading ']' or '-' is a member of the set, and ranges include
+     both end points.  */
+  TEST_COMPARE (sscanf ("]-]x", "%[]-]", s1), 1);
+  TEST_COMPARE_STRING (s1, "]-]");
+  TEST_COMPARE (sscanf ("a-c-b-e", "%[-a-c]", s1), 1);
+  TEST_COMPARE_STRING (s1, "a-c-b-");
+  TEST_COMPARE (sscanf ("0123456789", "%4[0-9]%[0-9]", s1, s2), 2);
+  TEST_COMPARE_STRING (s1, "0123");
+  TEST_COMPARE_STRING (s2, "456789");
+
+  /* %[ does not skip white space unless the format says so.  */
+  strcpy (s1, "unchanged");
+  TEST_COMPARE (sscanf (" abc", "%[a-z]", s1), 0);
+  TEST_COMPARE_STRING (s1, "unchanged");
+  TEST_COMPARE (sscanf (" abc", " %[a-z]", s1), 1);
+  TEST_COMPARE_STRING (s1, "abc");
+}
+
+static void
+check_failures (void)
+{
+  int i1 = -1, i2 = -1, n = -1;
+  char s1[32];
+
+  /* Input failures before the first conversion return EOF.  */
+  TEST_COMPARE (sscanf ("", "%d", &i1), EOF);
+  TEST_COMPARE (sscanf ("   ", "%s", s1), EOF);
+  TEST_COMPARE (sscanf ("", "%n%d", &n, &i1), EOF);
+  TEST_COMPARE (sscanf (" ", " x%d", &i1), EOF);
+  TEST_COMPARE (sscanf ("", "%%"), EOF);
+  TEST_COMPARE (sscanf ("", ""), 0);
+
+  /* After a successful conversion they return the count.  */
+  TEST_COMPARE (sscanf ("5", "%d%d", &i1, &i2), 1);
+  TEST_COMPARE (sscanf ("5 ", "%d %s", &i1, s1), 1);
+
+  /* Matching failures.  */
+  TEST_COMPARE (sscanf ("abc", "%d", &i1), 0);
+  TEST_COMPARE (sscanf ("-", "%d", &i1), 0);
+  TEST_COMPARE (sscanf ("+x", "%x", &i1), 0);
+  TEST_COMPARE (sscanf ("1;2", "%d,%d", &i1, &i2), 1);
+  TEST_COMPARE (sscanf ("%5", "%%%d", &i1), 1);
+  TEST_COMPARE (i1, 5);
+  TEST_COMPARE (sscanf ("5", "%d%%", &i1), 1);
+
+  /* %n after a failure is not reached.  */
+  n = -1;
+  TEST_COMPARE (sscanf ("1 x", "%d %d%n", &i1, &i2, &n), 1);
+  TEST_COMPARE (n, -1);
+
+  /* Trailing white space in the format consumes the input.  */
+  TEST_COMPARE (sscanf ("7  \t", "%d %n", &i1, &n), 1);
+  TEST_COMPARE (n, 4);
+}
+
+/* Formats the fast path leaves to the general code.  */
+static void
+check_general (void)
+{
+  int i1 = -1, i2 = -1;
+  char s1[32];
+  char *p = NULL;
+
+  TEST_COMPARE (sscanf ("12345", "%2d%d", &i1, &i2), 2);
+  TEST_COMPARE (i1, 12);
+  TEST_COMPARE (i2, 345);
+
+  TEST_COMPARE (sscanf ("1 2", "%2$d %1$d", &i1, &i2), 2);
+  TEST_COMPARE (i1, 2);
+  TEST_COMPARE (i2, 1);
+
+  TEST_COMPARE (sscanf ("0x10 010", "%i %o", &i1, &i2), 2);
+  TEST_COMPARE (i1, 16);
+  TEST_COMPARE (i2, 8);
+
+  TEST_COMPARE (sscanf ("word x", "%ms %c", &p, s1), 2);
+  TEST_COMPARE_STRING (p, "word");
+  TEST_COMPARE (s1[0], 'x');
+  free (p);
+}
+
+static int
+do_test (void)
+{
+  check_numbers ();
+  check_strings ();
+  check_failures ();
+  check_general ();
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -161,6 +161,46 @@ typedef wchar_t THOUSANDS_SEP_T;
 /* Include the shared code for parsing the format string.  */
 #include "printf-parse.h"
 
+#ifndef COMPILE_WPRINTF
+/* Write VALUE in decimal to BUF.  If the buffer has room for the
+   longest number, the digits are written into it directly, after
+   computing their count; otherwise they go through a local array.  */
+static void
+write_decimal_word (struct __printf_buffer *buf, unsigned long int value)
+{
+  enum { max_digits = sizeof (value) * CHAR_BIT * 30103 / 100000 + 1 };
+  static const unsigned long int powers_of_10[] =
+    {
+      1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL,
+      10000000UL, 100000000UL, 1000000000UL,
+# if ULONG_MAX > 0xffffffffUL
+      10000000000UL, 100000000000UL, 1000000000000UL,
+      10000000000000UL, 100000000000000UL, 1000000000000000UL,
+      10000000000000000UL, 100000000000000000UL,
+      1000000000000000000UL, 10000000000000000000UL,
+# endif
+    };
+
+  if (buf->write_end - buf->write_ptr >= max_digits)
+    {
+      /* log10 (2) is about 1233 / 4096, which gives the number of
+	 digits within one from the number of bits.  */
+      unsigned int bits = sizeof (value) * CHAR_BIT
+			  - __builtin_clzl (value | 1);
+      unsigned int log = (bits * 1233) >> 12;
+      unsigned int digits = log + 1 - ((value | 1) < powers_of_10[log]);
+      buf->write_ptr += digits;
+      _itoa_word_decimal (value, buf->write_ptr);
+    }
+  else
+    {
+      char work[max_digits];
+      char *string = _itoa_word_decimal (value, work + max_digits);
+      __printf_buffer_write (buf, string, work + max_digits - string);
+    }
+}
+#endif
+
 
 /* Write the string SRC to S.  If PREC is non-negative, write at most
    PREC bytes.  If LEFT is true, perform left justification.  */
@@ -1094,6 +1134,29 @@ printf_positional (struct Xprintf_buffer * buf, const CHAR_T *format,
 	grouping = NULL;
     }
 
+#ifndef COMPILE_WPRINTF
+  /* Reuse the specs of an earlier call with the same format string if
+     the per-thread cache is enabled.  */
+  {
+    size_t cached_nspecs;
+    const struct printf_spec *cached
+      = __printf_spec_cache_lookup (lead_str_end, &cached_nspecs, &nargs);
+    if (cached != NULL)
+      {
+	if (!scratch_buffer_set_array_size (&specsbuf, cached_nspecs,
+					    sizeof (specs[0])))
+	  {
+	    Xprintf_buffer_mark_failed (buf);
+	    goto all_done;
+	  }
+	specs = specsbuf.data;
+	nspecs = cached_nspecs;
+	memcpy (specs, cached, nspecs * sizeof (specs[0]));
+	goto specs_done;
+      }
+  }
+#endif
+
   for (const UCHAR_T *f = lead_str_end; *f != L_('\0');
        f = specs[nspecs++].next_fmt)
     {
@@ -1124,6 +1187,12 @@ printf_positional (struct Xprintf_buffer * buf, const CHAR_T *format,
 	}
     }
 
+#ifndef COMPILE_WPRINTF
+  __printf_spec_cache_insert (lead_str_end, specs, nspecs,
+			      MAX (nargs, max_ref_arg));
+
+ specs_done:
+#endif
   /* Determine the number of arguments the format string consumes.  */
   nargs = MAX (nargs, max_ref_arg);
 
@@ -133,6 +133,26 @@ LABEL (unsigned_number):      /* Unsigned number of base BASE.  */
         number.word = (unsigned short int) process_arg_unsigned_int ();
 
       LABEL (number):
+#ifndef COMPILE_WPRINTF
+      /* Plain conversions such as %d, %lu or %x, without flags, width
+         or precision, need none of the padding logic below.  */
+      if (prec < 0 && width == 0 && !alt && !showsign && !space && !group
+          && !(use_outdigits && base == 10))
+        {
+          if (is_negative)
+            Xprintf_buffer_putc (buf, L_('-'));
+          if (base == 10)
+            write_decimal_word (buf, number.word);
+          else
+            {
+              string = _itoa_word (number.word, workend, base,
+                                   spec == L_('X'));
+              Xprintf_buffer_write (buf, string, workend - string);
+            }
+          break;
+        }
+#endif
+
       if (prec < 0)
         /* Supply a default precision if none was given.  */
         prec = 1;
@@ -263,6 +263,409 @@ char_buffer_add (struct char_buffer *buffer, CHAR_T ch)
     *buffer->current++ = ch;
 }
 
+#ifndef COMPILE_WSCANF
+/* The sscanf family reads from a string stream which is private to the
+   call and needs no locking.  Formats which only use the common
+   conversions %d, %u, %x, %s, %[...] and %n are scanned below directly
+   on the string, without going through inchar and ungetc for every
+   character.  Everything else, including field widths on numbers,
+   positional arguments, the ', I, a and m flags, and multibyte
+   characters in the format, is left to the general code.  The fast
+   path must behave exactly like the general one, including the
+   treatment of white space and the return value on input and matching
+   failures.  */
+
+/* A conversion specification accepted by the fast path.  */
+struct string_scanf_spec
+{
+  int flags;
+  /* Maximum field width, -1 if none.  */
+  int width;
+  /* The conversion specifier character.  */
+  unsigned char conv;
+  /* For %[, the scanlist after the optional '^'.  */
+  const unsigned char *set;
+  bool set_negated;
+};
+
+/* Parse the conversion specification after the '%' at F into SPEC.
+   Return a pointer to the character after it, or NULL if the fast
+   path does not handle it.  */
+static const unsigned char *
+string_scanf_parse (const unsigned char *f, struct string_scanf_spec *spec)
+{
+  spec->flags = 0;
+  while (*f == '*')
+    {
+      spec->flags |= SUPPRESS;
+      ++f;
+    }
+
+  /* Larger widths are treated specially by read_int, so leave them
+     to the general code.  */
+  spec->width = 0;
+  for (int n = 0; *f >= '0' && *f <= '9'; ++n)
+    {
+      if (n == 6)
+	return NULL;
+      spec->width = spec->width * 10 + (*f++ - '0');
+    }
+  if (spec->width == 0)
+    spec->width = -1;
+
+  switch (*f++)
+    {
+    case 'h':
+      if (*f == 'h')
+	{
+	  ++f;
+	  spec->flags |= CHAR;
+	}
+      else
+	spec->flags |= SHORT;
+      break;
+    case 'l':
+      if (*f == 'l')
+	{
+	  ++f;
+	  spec->flags |= LONGDBL | LONG;
+	}
+      else
+	spec->flags |= LONG;
+      break;
+    case 'q':
+    case 'L':
+      spec->flags |= LONGDBL | LONG;
+      break;
+    case 'z':
+      if (need_longlong && sizeof (size_t) > sizeof (unsigned long int))
+	spec->flags |= LONGDBL;
+      else if (sizeof (size_t) > sizeof (unsigned int))
+	spec->flags |= LONG;
+      break;
+    case 'j':
+      if (need_longlong && sizeof (uintmax_t) > sizeof (unsigned long int))
+	spec->flags |= LONGDBL;
+      else if (sizeof (uintmax_t) > sizeof (unsigned int))
+	spec->flags |= LONG;
+      break;
+    case 't':
+      if (need_longlong && sizeof (ptrdiff_t) > sizeof (long int))
+	spec->flags |= LONGDBL;
+      else if (sizeof (ptrdiff_t) > sizeof (int))
+	spec->flags |= LONG;
+      break;
+    default:
+      --f;
+      break;
+    }
+
+  spec->conv = *f++;
+  switch (spec->conv)
+    {
+    case '%':
+    case 'n':
+      return f;
+
+    case 'd':
+    case 'u':
+    case 'x':
+    case 'X':
+      return spec->width == -1 ? f : NULL;
+
+    case 's':
+      return (spec->flags & ~SUPPRESS) == 0 ? f : NULL;
+
+    case '[':
+      if ((spec->flags & ~SUPPRESS) != 0)
+	return NULL;
+      spec->set_negated = *f == '^';
+      if (spec->set_negated)
+	++f;
+      spec->set = f;
+      /* A leading ']' is part of the set.  */
+      if (*f == ']')
+	++f;
+      while (*f != ']')
+	if (*f++ == '\0')
+	  return NULL;
+      return f + 1;
+
+    default:
+      return NULL;
+    }
+}
+
+/* Return true if the fast path can scan S according to FORMAT.  */
+static bool
+string_scanf_usable (FILE *s, const unsigned char *format)
+{
+  /* Only the string streams set up by the sscanf family qualify.  */
+  if (_IO_JUMPS_FILE_plus (s) != &_IO_str_jumps
+      || (s->_flags & (_IO_USER_LOCK | _IO_IN_BACKUP | _IO_CURRENTLY_PUTTING))
+	 != _IO_USER_LOCK
+      || s->_IO_write_ptr > s->_IO_read_end)
+    return false;
+
+  struct string_scanf_spec spec;
+  const unsigned char *f = format;
+  while (*f != '\0')
+    {
+      if (!isascii (*f))
+	return false;
+      if (*f++ == '%')
+	{
+	  f = string_scanf_parse (f, &spec);
+	  if (f == NULL)
+	    return false;
+	}
+    }
+  return true;
+}
+
+/* Scan the string stream S according to FORMAT, which has been
+   accepted by string_scanf_usable.  Arguments are taken from ARG.  */
+static int
+string_scanf (FILE *s, const unsigned char *f, va_list arg, locale_t loc)
+{
+  const unsigned char *const start = (const unsigned char *) s->_IO_read_ptr;
+  const unsigned char *const end = (const unsigned char *) s->_IO_read_end;
+  const unsigned char *p = start;
+  int done = 0;
+  bool skip_space = false;
+  struct string_scanf_spec spec;
+
+  while (*f != '\0')
+    {
+      unsigned char fc = *f++;
+      if (fc != '%')
+	{
+	  if (ISSPACE (fc))
+	    {
+	      skip_space = true;
+	      continue;
+	    }
+	  if (p == end)
+	    goto input_error;
+	  if (skip_space)
+	    {
+	      while (ISSPACE (*p))
+		if (++p == end)
+		  goto input_error;
+	      skip_space = false;
+	    }
+	  if (*p != fc)
+	    goto out;
+	  ++p;
+	  continue;
+	}
+
+      f = string_scanf_parse (f, &spec);
+      int flags = spec.flags;
+
+      if (skip_space || (spec.conv != '[' && spec.conv != 'n'))
+	{
+	  while (p < end && ISSPACE (*p))
+	    ++p;
+	  skip_space = false;
+	}
+
+      switch (spec.conv)
+	{
+	case '%':
+	  if (p == end)
+	    goto input_error;
+	  if (*p != '%')
+	    goto out;
+	  ++p;
+	  break;
+
+	case 'n':
+	  if (!(flags & SUPPRESS))
+	    {
+	      size_t read_in = p - start;
+	      if (need_longlong && (flags & LONGDBL))
+		*va_arg (arg, long long int *) = read_in;
+	      else if (need_long && (flags & LONG))
+		*va_arg (arg, long int *) = read_in;
+	      else if (flags & SHORT)
+		*va_arg (arg, short int *) = read_in;
+	      else if (!(flags & CHAR))
+		*va_arg (arg, int *) = read_in;
+	      else
+		*va_arg (arg, char *) = read_in;
+	    }
+	  break;
+
+	case 's':
+	case '[':
+	  {
+	    char *str = NULL;
+	    if (!(flags & SUPPRESS))
+	      {
+		str = va_arg (arg, char *);
+		if (str == NULL)
+		  goto out;
+	      }
+
+	    /* For %s, the set of characters which end the string.  */
+	    bool not_in = false;
+	    char table[UCHAR_MAX + 1];
+	    if (spec.conv == '[')
+	      {
+		/* Build the flag map the same way as the general code.  */
+		const unsigned char *sf = spec.set;
+		memset (table, '\0', sizeof (table));
+		fc = *sf;
+		if (fc == ']' || fc == '-')
+		  {
+		    table[fc] = 1;
+		    ++sf;
+		  }
+		while ((fc = *sf++) != ']')
+		  if (fc == '-' && *sf != ']' && sf[-2] <= *sf)
+		    for (fc = sf[-2]; fc < *sf; ++fc)
+		      table[fc] = 1;
+		  else
+		    table[fc] = 1;
+		not_in = spec.set_negated;
+	      }
+
+	    if (p == end)
+	      goto input_error;
+
+	    const unsigned char *cp = p;
+	    size_t width = spec.width < 0 ? SIZE_MAX : spec.width;
+	    if (spec.conv == 's')
+	      while (cp < end && (size_t) (cp - p) < width && !ISSPACE (*cp))
+		++cp;
+	    else
+	      while (cp < end && (size_t) (cp - p) < width
+		     && table[*cp] != not_in)
+		++cp;
+
+	    if (spec.conv == '[' && cp == p)
+	      goto out;
+
+	    if (!(flags & SUPPRESS))
+	      {
+		*(char *) __mempcpy (str, p, cp - p) = '\0';
+		++done;
+	      }
+	    p = cp;
+	  }
+	  break;
+
+	default:
+	  {
+	    /* d, u, x and X.  Find the end of the number the same way
+	       as the general code, then convert it in place.  */
+	    int base = spec.conv == 'x' || spec.conv == 'X' ? 16 : 10;
+	    bool is_signed = spec.conv == 'd';
+
+	    if (p == end)
+	      goto input_error;
+
+	    const unsigned char *cp = p;
+	    if (*cp == '-' || *cp == '+')
+	      ++cp;
+	    const unsigned char *digits = cp;
+	    if (cp < end && *cp == '0')
+	      {
+		++cp;
+		/* The prefix is consumed even if no digit follows it.  */
+		if (base == 16 && cp < end && TOLOWER (*cp) == 'x')
+		  ++cp;
+	      }
+	    bool any = cp != digits;
+	    while (cp < end && (base == 16 ? ISXDIGIT (*cp) : ISDIGIT (*cp)))
+	      {
+		++cp;
+		any = true;
+	      }
+	    if (!any)
+	      goto out;
+
+	    /* The string of the sscanf family ends with a null byte at
+	       END, so the conversion cannot run past it, and it stops
+	       at CP or earlier.  */
+	    union
+	    {
+	      long long int q;
+	      unsigned long long int uq;
+	      long int l;
+	      unsigned long int ul;
+	    } num;
+	    char *tw;
+	    if (need_longlong && (flags & LONGDBL))
+	      {
+		if (is_signed)
+		  num.q = __strtoll_internal ((const char *) p, &tw, base, 0);
+		else
+		  num.uq = __strtoull_internal ((const char *) p, &tw, base, 0);
+	      }
+	    else
+	      {
+		if (is_signed)
+		  num.l = __strtol_internal ((const char *) p, &tw, base, 0);
+		else
+		  num.ul = __strtoul_internal ((const char *) p, &tw, base, 0);
+	      }
+	    if (__glibc_unlikely ((const unsigned char *) tw == p))
+	      goto out;
+	    p = cp;
+
+	    if (!(flags & SUPPRESS))
+	      {
+		if (is_signed)
+		  {
+		    if (need_longlong && (flags & LONGDBL))
+		      *va_arg (arg, LONGLONG int *) = num.q;
+		    else if (need_long && (flags & LONG))
+		      *va_arg (arg, long int *) = num.l;
+		    else if (flags & SHORT)
+		      *va_arg (arg, short int *) = (short int) num.l;
+		    else if (!(flags & CHAR))
+		      *va_arg (arg, int *) = (int) num.l;
+		    else
+		      *va_arg (arg, signed char *) = (signed char) num.ul;
+		  }
+		else
+		  {
+		    if (need_longlong && (flags & LONGDBL))
+		      *va_arg (arg, unsigned LONGLONG int *) = num.uq;
+		    else if (need_long && (flags & LONG))
+		      *va_arg (arg, unsigned long int *) = num.ul;
+		    else if (flags & SHORT)
+		      *va_arg (arg, unsigned short int *)
+			= (unsigned short int) num.ul;
+		    else if (!(flags & CHAR))
+		      *va_arg (arg, unsigned int *) = (unsigned int) num.ul;
+		    else
+		      *va_arg (arg, unsigned char *) = (unsigned char) num.ul;
+		  }
+		++done;
+	      }
+	  }
+	  break;
+	}
+    }
+
+  /* Consume trailing white space if the format ends with it.  */
+  if (skip_space)
+    while (p < end && ISSPACE (*p))
+      ++p;
+  goto out;
+
+ input_error:
+  if (done == 0)
+    done = EOF;
+ out:
+  s->_IO_read_ptr = (char *) p;
+  return done;
+}
+#endif /* !COMPILE_WSCANF */
+
 /* Read formatted input from S according to the format string
    FORMAT, using the argument list in ARG.
    Return the number of assignments made, or -1 for an input error.  */
@@ -347,6 +750,11 @@ __vfscanf_internal (FILE *s, const char *format, va_list argptr,
 
   ARGCHECK (s, format);
 
+#ifndef COMPILE_WSCANF
+  if (string_scanf_usable (s, f))
+    return string_scanf (s, f, arg, loc);
+#endif
+
  {
 #ifndef COMPILE_WSCANF
    struct __locale_data *const curnumeric = loc->__locales[LC_NUMERIC];
@@ -18,11 +18,48 @@
 
 #include <errno.h>
 #include <not-cancel.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/random.h>
+#include <tls-internal.h>
+#include <chacha20.c>
+
+/* arc4random generates its output with ChaCha20, keyed from the
+   kernel entropy pool.  Each thread has its own cipher state, so the
+   common case needs neither a system call nor a lock.
+
+   The keystream is generated CHACHA20_BUFSIZE bytes at a time.  The
+   first CHACHA20_KEY_SIZE + CHACHA20_IV_SIZE bytes of each buffer
+   immediately replace the key, so that output which has already been
+   handed out cannot be recomputed from the state (fast key erasure),
+   and the remaining bytes are cleared as they are consumed.  After
+   CHACHA20_RESEED_SIZE bytes of output, the key is replaced with fresh
+   entropy.
+
+   The state is kept in its own anonymous mapping marked with
+   MADV_WIPEONFORK, so that the child of a fork starts with a zeroed
+   state and reseeds before producing any output, even if the process
+   was created without going through fork or _Fork.  On kernels without
+   MADV_WIPEONFORK, _Fork clears the state of the calling thread in the
+   child.  */
+
+/* Reseed after this many bytes of output.  */
+#define CHACHA20_RESEED_SIZE (16 * 1024 * 1024)
+
+struct arc4random_state_t
+{
+  uint32_t ctx[CHACHA20_STATE_LEN];
+  uint8_t buf[CHACHA20_BUFSIZE];
+  /* Number of unused bytes at the end of buf.  */
+  size_t have;
+  /* Number of bytes which can be generated before the next reseed.
+     Zero if the state has not been seeded yet.  */
+  size_t count;
+};
 
 static void
 arc4random_getrandom_failure (void)
@@ -31,7 +68,7 @@ arc4random_getrandom_failure (void)
 }
 
 void
-__arc4random_buf (void *p, size_t n)
+__arc4random_buf_internal (void *p, size_t n)
 {
   static int seen_initialized;
   ssize_t l;
@@ -88,9 +125,120 @@ __arc4random_buf (void *p, size_t n)
   if (__close_nocancel (fd) < 0)
     arc4random_getrandom_failure ();
 }
+
+/* Return the state of the calling thread, allocating it if necessary.
+   Returns NULL if the state cannot be allocated.  */
+static struct arc4random_state_t *
+arc4random_get_state (void)
+{
+  struct tls_internal_t *tls = __glibc_tls_internal ();
+  struct arc4random_state_t *state = tls->rand_state;
+  if (__glibc_likely (state != NULL))
+    return state;
+
+  state = __mmap (NULL, sizeof (*state), PROT_READ | PROT_WRITE,
+		  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (state == MAP_FAILED)
+    return NULL;
+#ifdef MADV_WIPEONFORK
+  /* Failure is not fatal, _Fork clears the state as well.  */
+  __madvise (state, sizeof (*state), MADV_WIPEONFORK);
+#endif
+  tls->rand_state = state;
+  return state;
+}
+
+/* Replace the key with fresh entropy.  */
+static void
+arc4random_stir (struct arc4random_state_t *state)
+{
+  uint8_t rnd[CHACHA20_KEY_SIZE + CHACHA20_IV_SIZE];
+  __arc4random_buf_internal (rnd, sizeof (rnd));
+  chacha20_init (state->ctx, rnd, rnd + CHACHA20_KEY_SIZE);
+  explicit_bzero (rnd, sizeof (rnd));
+
+  explicit_bzero (state->buf, sizeof (state->buf));
+  state->have = 0;
+  state->count = CHACHA20_RESEED_SIZE;
+}
+
+/* Refill the keystream buffer, and use its beginning as the new key.  */
+static void
+arc4random_rekey (struct arc4random_state_t *state)
+{
+  chacha20_blocks (state->ctx, state->buf);
+  chacha20_init (state->ctx, state->buf, state->buf + CHACHA20_KEY_SIZE);
+  explicit_bzero (state->buf, CHACHA20_KEY_SIZE + CHACHA20_IV_SIZE);
+  state->have = sizeof (state->buf) - CHACHA20_KEY_SIZE - CHACHA20_IV_SIZE;
+}
+
+void
+__arc4random_buf (void *p, size_t n)
+{
+  if (n == 0)
+    return;
+
+  struct arc4random_state_t *state = arc4random_get_state ();
+  if (__glibc_unlikely (state == NULL))
+    {
+      __arc4random_buf_internal (p, n);
+      return;
+    }
+
+  if (state->count <= n)
+    arc4random_stir (state);
+  state->count = state->count <= n ? 0 : state->count - n;
+
+  uint8_t *buf = p;
+  bool bypassed = false;
+  while (n > 0)
+    {
+      if (state->have == 0)
+	{
+	  /* Large requests are served from the keystream directly.
+	     The key is replaced below before returning.  */
+	  if (n >= CHACHA20_BUFSIZE)
+	    {
+	      chacha20_blocks (state->ctx, buf);
+	      buf += CHACHA20_BUFSIZE;
+	      n -= CHACHA20_BUFSIZE;
+	      bypassed = true;
+	      continue;
+	    }
+	  arc4random_rekey (state);
+	  bypassed = false;
+	}
+
+      size_t m = MIN (n, state->have);
+      uint8_t *keystream = state->buf + sizeof (state->buf) - state->have;
+      memcpy (buf, keystream, m);
+      explicit_bzero (keystream, m);
+      buf += m;
+      n -= m;
+      state->have -= m;
+    }
+
+  if (bypassed)
+    arc4random_rekey (state);
+}
 libc_hidden_def (__arc4random_buf)
 weak_alias (__arc4random_buf, arc4random_buf)
 
+void
+__arc4random_fork_subprocess (void)
+{
+  struct arc4random_state_t *state = __glibc_tls_internal ()->rand_state;
+  if (state != NULL)
+    memset (state, 0, sizeof (*state));
+}
+
+void
+__arc4random_state_free (struct arc4random_state_t *state)
+{
+  if (state != NULL)
+    __munmap (state, sizeof (*state));
+}
+
 uint32_t
 __arc4random (void)
 {
@@ -0,0 +1,124 @@
+/* Basic ChaCha20 routines.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <endian.h>
+#include <stdint.h>
+#include <string.h>
+
+/* 32-bit block counter followed by a 96-bit nonce, as in RFC 8439.  */
+#define CHACHA20_IV_SIZE	16
+#define CHACHA20_KEY_SIZE	32
+
+#define CHACHA20_STATE_LEN	16
+#define CHACHA20_BLOCK_SIZE	64
+
+/* Number of blocks generated by each call to chacha20_blocks.  The
+   blocks are computed in parallel, with one vector lane per block, so
+   the compiler can use the SIMD registers of the baseline ISA (SSE2 on
+   x86_64, Advanced SIMD on AArch64).  */
+#define CHACHA20_BLOCKS		8
+#define CHACHA20_BUFSIZE	(CHACHA20_BLOCKS * CHACHA20_BLOCK_SIZE)
+
+enum chacha20_constants
+{
+  CHACHA20_CONSTANT_EXPA = 0x61707865U,
+  CHACHA20_CONSTANT_ND_3 = 0x3320646eU,
+  CHACHA20_CONSTANT_2_BY = 0x79622d32U,
+  CHACHA20_CONSTANT_TE_K = 0x6b206574U
+};
+
+static inline uint32_t
+read_unaligned_32 (const uint8_t *p)
+{
+  uint32_t r;
+  memcpy (&r, p, sizeof (r));
+  return le32toh (r);
+}
+
+static inline void
+write_unaligned_32 (uint8_t *p, uint32_t v)
+{
+  v = htole32 (v);
+  memcpy (p, &v, sizeof (v));
+}
+
+static inline void
+chacha20_init (uint32_t *state, const uint8_t *key, const uint8_t *iv)
+{
+  state[0]  = CHACHA20_CONSTANT_EXPA;
+  state[1]  = CHACHA20_CONSTANT_ND_3;
+  state[2]  = CHACHA20_CONSTANT_2_BY;
+  state[3]  = CHACHA20_CONSTANT_TE_K;
+
+  for (int i = 0; i < CHACHA20_KEY_SIZE / sizeof (uint32_t); i++)
+    state[4 + i] = read_unaligned_32 (key + i * sizeof (uint32_t));
+  for (int i = 0; i < CHACHA20_IV_SIZE / sizeof (uint32_t); i++)
+    state[12 + i] = read_unaligned_32 (iv + i * sizeof (uint32_t));
+}
+
+static inline uint32_t
+rotl32 (unsigned int shift, uint32_t word)
+{
+  return (word << (shift & 31)) | (word >> ((-shift) & 31));
+}
+
+/* Apply the quarter round to word A, B, C and D of all the blocks in
+   X.  */
+#define QROUND(x, a, b, c, d)						\
+  for (int j = 0; j < CHACHA20_BLOCKS; j++)				\
+    {									\
+      x[a][j] += x[b][j]; x[d][j] = rotl32 (16, x[d][j] ^ x[a][j]);	\
+      x[c][j] += x[d][j]; x[b][j] = rotl32 (12, x[b][j] ^ x[c][j]);	\
+      x[a][j] += x[b][j]; x[d][j] = rotl32 (8,  x[d][j] ^ x[a][j]);	\
+      x[c][j] += x[d][j]; x[b][j] = rotl32 (7,  x[b][j] ^ x[c][j]);	\
+    }
+
+/* Write CHACHA20_BUFSIZE bytes of keystream for STATE to DST, and
+   advance the block counter in STATE.  */
+static void
+chacha20_blocks (uint32_t *state, uint8_t *dst)
+{
+  uint32_t x[CHACHA20_STATE_LEN][CHACHA20_BLOCKS];
+
+  for (int i = 0; i < CHACHA20_STATE_LEN; i++)
+    for (int j = 0; j < CHACHA20_BLOCKS; j++)
+      x[i][j] = state[i];
+  for (int j = 0; j < CHACHA20_BLOCKS; j++)
+    x[12][j] += j;
+
+  for (int i = 0; i < 20; i += 2)
+    {
+      QROUND (x, 0, 4,  8, 12);
+      QROUND (x, 1, 5,  9, 13);
+      QROUND (x, 2, 6, 10, 14);
+      QROUND (x, 3, 7, 11, 15);
+
+      QROUND (x, 0, 5, 10, 15);
+      QROUND (x, 1, 6, 11, 12);
+      QROUND (x, 2, 7,  8, 13);
+      QROUND (x, 3, 4,  9, 14);
+    }
+
+  for (int j = 0; j < CHACHA20_BLOCKS; j++)
+    for (int i = 0; i < CHACHA20_STATE_LEN; i++)
+      write_unaligned_32 (dst + j * CHACHA20_BLOCK_SIZE
+			  + i * sizeof (uint32_t),
+			  x[i][j] + state[i] + (i == 12 ? j : 0));
+
+  state[12] += CHACHA20_BLOCKS;
+}
@@ -0,0 +1,167 @@
+/* Eisel-Lemire algorithm for converting decimal numbers to binary.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _EISEL_LEMIRE_H
+#define _EISEL_LEMIRE_H 1
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* The algorithm is described in Daniel Lemire, "Number Parsing at a
+   Gigabyte per Second", Software: Practice and Experience 51 (2021),
+   and in Noble Mushtak and Daniel Lemire, "Fast Number Parsing Without
+   Fallback", Software: Practice and Experience 53 (2023).  It computes
+   the binary floating-point number nearest to W * 10^Q, for a 64-bit W,
+   with a 64 by 128-bit multiplication by a truncated power of five.  It
+   gives up in the rare cases where the truncation might affect the
+   result, and for results which are subnormal or overflow, so that the
+   caller can use its exact but slower algorithm.  */
+
+/* Range of Q covered by __eisel_lemire_pow5.  Decimal numbers with 19
+   significant digits outside of this range are zero or infinite in
+   double precision.  */
+#define EISEL_LEMIRE_MIN_POW10	(-342)
+#define EISEL_LEMIRE_MAX_POW10	308
+
+extern const uint64_t __eisel_lemire_pow5[EISEL_LEMIRE_MAX_POW10
+					  - EISEL_LEMIRE_MIN_POW10 + 1][2]
+  attribute_hidden;
+
+/* Return the 128-bit product of A and B in *HI and *LO.  */
+static inline void
+eisel_lemire_mul (uint64_t a, uint64_t b, uint64_t *hi, uint64_t *lo)
+{
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 p = (unsigned __int128) a * b;
+  *hi = p >> 64;
+  *lo = p;
+#else
+  uint64_t a_lo = (uint32_t) a, a_hi = a >> 32;
+  uint64_t b_lo = (uint32_t) b, b_hi = b >> 32;
+  uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi;
+  uint64_t hl = a_hi * b_lo, hh = a_hi * b_hi;
+  uint64_t mid = (ll >> 32) + (uint32_t) lh + (uint32_t) hl;
+  *hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+  *lo = (mid << 32) | (uint32_t) ll;
+#endif
+}
+
+/* Return true if W * 10^Q, which must be nonzero and in the range of
+   normal numbers, is representable with MANT_DIG bits of precision.
+   This is the case if the odd part of W * 5^Q is an integer of at most
+   MANT_DIG bits.  Since W is below 2^64 < 5^28, the loops run at most
+   27 times, and usually end after the first iteration.  */
+static inline bool
+eisel_lemire_exact (uint64_t w, int q, int mant_dig)
+{
+  uint64_t odd = w >> __builtin_ctzll (w);
+  for (; q > 0; --q)
+    {
+      if (odd >> mant_dig != 0)
+	return false;
+      odd *= 5;
+    }
+  for (; q < 0; ++q)
+    {
+      if (odd % 5 != 0)
+	return false;
+      odd /= 5;
+    }
+  return odd >> mant_dig == 0;
+}
+
+/* Compute the IEEE binary floating-point number with MANT_DIG bits of
+   precision and maximum exponent MAX_EXP nearest to W * 10^Q, rounding
+   to even.  W must be nonzero.  On success, store the significand,
+   including the implicit bit, in *MANTISSA and the unbiased exponent in
+   *EXPONENT, so that the number is *MANTISSA * 2^(*EXPONENT - MANT_DIG
+   + 1), store in *EXACT whether the number is equal to W * 10^Q, and
+   return true.  Return false if the result cannot be determined or is
+   not a normal number.  Only the double and float formats are
+   supported.  */
+static inline bool
+eisel_lemire (uint64_t w, int q, int mant_dig, int max_exp,
+	      uint64_t *mantissa, int *exponent, bool *exact)
+{
+  const int explicit_bits = mant_dig - 1;
+  const int bias = max_exp - 1;
+  /* Range of Q for which the product can be exactly half-way between
+     two floating-point numbers.  */
+  const int min_round_to_even = mant_dig == 24 ? -17 : -4;
+  const int max_round_to_even = mant_dig == 24 ? 10 : 23;
+
+  if (q < EISEL_LEMIRE_MIN_POW10 || q > EISEL_LEMIRE_MAX_POW10)
+    return false;
+
+  int lz = __builtin_clzll (w);
+  w <<= lz;
+
+  /* Multiply by the 64 most significant bits of 5^Q first.  The
+     second multiplication is only needed if the bits below the ones
+     which determine the result are all set, so that the truncated
+     part of the power could carry into them.  */
+  const uint64_t *pow5 = __eisel_lemire_pow5[q - EISEL_LEMIRE_MIN_POW10];
+  const uint64_t precision_mask = UINT64_MAX >> (explicit_bits + 3);
+  uint64_t hi, lo;
+  eisel_lemire_mul (w, pow5[0], &hi, &lo);
+  if ((hi & precision_mask) == precision_mask)
+    {
+      uint64_t hi2, lo2;
+      eisel_lemire_mul (w, pow5[1], &hi2, &lo2);
+      lo += hi2;
+      if (hi2 > lo)
+	++hi;
+      /* The result might still be inexact.  */
+      if (lo == UINT64_MAX && (q < -27 || q > 55))
+	return false;
+    }
+
+  int upperbit = hi >> 63;
+  int shift = upperbit + 64 - explicit_bits - 3;
+  uint64_t m = hi >> shift;
+  /* floor (log2 (10^Q)) + 63 is (217706 * Q >> 16) + 63.  */
+  int power2 = ((217706 * q) >> 16) + 63 + upperbit - lz + bias;
+  if (power2 <= 0)
+    /* Subnormal number.  */
+    return false;
+
+  /* If the product is exact and exactly half-way between two numbers,
+     round to even instead of up.  */
+  if (lo <= 1 && q >= min_round_to_even && q <= max_round_to_even
+      && (m & 3) == 1 && (m << shift) == hi)
+    m &= ~(uint64_t) 1;
+
+  m += m & 1;
+  m >>= 1;
+  if (m >= (uint64_t) 2 << explicit_bits)
+    {
+      m = (uint64_t) 1 << explicit_bits;
+      ++power2;
+    }
+
+  if (power2 >= 2 * max_exp - 1)
+    /* Overflow.  */
+    return false;
+
+  *mantissa = m;
+  *exponent = power2 - bias;
+  *exact = eisel_lemire_exact (w >> lz, q, mant_dig);
+  return true;
+}
+
+#endif /* eisel-lemire.h */
@@ -17,232 +17,486 @@
 
 /* If you consider tuning this algorithm, you should consult first:
    Engineering a sort function; Jon Bentley and M. Douglas McIlroy;
-   Software - Practice and Experience; Vol. 23 (11), 1249-1265, 1993.  */
+   Software - Practice and Experience; Vol. 23 (11), 1249-1265, 1993.
+   Pattern-defeating Quicksort; Orson R. L. Peters; arXiv:2106.05123,
+   2021.  */
 
-#include <alloca.h>
 #include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
-/* Byte-wise swap two items of size SIZE. */
-#define SWAP(a, b, size)						      \
-  do									      \
-    {									      \
-      size_t __size = (size);						      \
-      char *__a = (a), *__b = (b);					      \
-      do								      \
-	{								      \
-	  char __tmp = *__a;						      \
-	  *__a++ = *__b;						      \
-	  *__b++ = __tmp;						      \
-	} while (--__size > 0);						      \
-    } while (0)
-
-/* Discontinue quicksort algorithm when partition gets below this size.
-   This particular magic number was chosen to work best on a Sun 4/260. */
-#define MAX_THRESH 4
-
-/* Stack node declarations used to store unfulfilled partition obligations. */
+/* The element sizes for which the sort loops are specialized.  For these
+   the element size is a compile-time constant and two elements are
+   swapped with word loads and stores.  */
+enum swap_type_t
+  {
+    SWAP_WORDS_32,
+    SWAP_WORDS_64,
+    SWAP_WORDS_128,
+    SWAP_BYTES
+  };
+
+typedef uint32_t __attribute__ ((__may_alias__)) u32_alias_t;
+typedef uint64_t __attribute__ ((__may_alias__)) u64_alias_t;
+
+/* Byte-wise swap two items of size SIZE.  Use fixed-size memcpy calls
+   for the bulk of the element, which the compiler expands inline.  */
+static inline void
+swap_bytes (void *a, void *b, size_t size)
+{
+  enum { SWAP_GENERIC_SIZE = 32 };
+  unsigned char tmp[SWAP_GENERIC_SIZE];
+  unsigned char *pa = a, *pb = b;
+
+  while (size > SWAP_GENERIC_SIZE)
+    {
+      memcpy (tmp, pa, SWAP_GENERIC_SIZE);
+      memcpy (pa, pb, SWAP_GENERIC_SIZE);
+      memcpy (pb, tmp, SWAP_GENERIC_SIZE);
+      pa += SWAP_GENERIC_SIZE;
+      pb += SWAP_GENERIC_SIZE;
+      size -= SWAP_GENERIC_SIZE;
+    }
+  while (size > 0)
+    {
+      unsigned char t = pa[--size];
+      pa[size] = pb[size];
+      pb[size] = t;
+    }
+}
+
+/* Swap the items at A and B, of SIZE bytes and swap type TYPE.  */
+static inline __attribute__ ((always_inline)) void
+do_swap (void *a, void *b, size_t size,
+	 enum swap_type_t type)
+{
+  switch (type)
+    {
+    case SWAP_WORDS_32:
+      {
+	uint32_t t = *(u32_alias_t *) a;
+	*(u32_alias_t *) a = *(u32_alias_t *) b;
+	*(u32_alias_t *) b = t;
+      }
+      break;
+    case SWAP_WORDS_128:
+      {
+	uint64_t t = ((u64_alias_t *) a)[1];
+	((u64_alias_t *) a)[1] = ((u64_alias_t *) b)[1];
+	((u64_alias_t *) b)[1] = t;
+      }
+      /* Fall through.  */
+    case SWAP_WORDS_64:
+      {
+	uint64_t t = *(u64_alias_t *) a;
+	*(u64_alias_t *) a = *(u64_alias_t *) b;
+	*(u64_alias_t *) b = t;
+      }
+      break;
+    default:
+      swap_bytes (a, b, size);
+    }
+}
+
+static enum swap_type_t
+get_swap_type (void *const pbase, size_t size)
+{
+  if (size == sizeof (uint32_t)
+      && ((uintptr_t) pbase) % __alignof__ (uint32_t) == 0)
+    return SWAP_WORDS_32;
+  if ((size == sizeof (uint64_t) || size == 2 * sizeof (uint64_t))
+      && ((uintptr_t) pbase) % __alignof__ (uint64_t) == 0)
+    return size == sizeof (uint64_t) ? SWAP_WORDS_64 : SWAP_WORDS_128;
+  return SWAP_BYTES;
+}
+
+/* Partitions below this number of elements are sorted using insertion
+   sort.  */
+#define INSERTION_SORT_THRESHOLD 16
+
+/* Above this number of elements the pivot is chosen as the median of
+   three medians (Tukey's ninther) instead of the median of three.  */
+#define NINTHER_THRESHOLD 128
+
+/* Maximum number of elements moved by the insertion sort which is tried
+   on partitions that were already partitioned.  */
+#define PARTIAL_INSERTION_SORT_LIMIT 8
+
+/* Stack node declarations used to store unfulfilled partition
+   obligations.  Partitions are the half-open ranges [LO, HI).  */
 typedef struct
   {
     char *lo;
     char *hi;
+    /* Number of unbalanced partitions still allowed before switching
+       to heapsort.  */
+    int bad_allowed;
   } stack_node;
 
 /* The next 4 #defines implement a very fast in-line stack abstraction. */
-/* The stack needs log (total_elements) entries (we could even subtract
-   log(MAX_THRESH)).  Since total_elements has type size_t, we get as
-   upper bound for log (total_elements):
+/* The larger of the two partitions is always pushed on the stack, so
+   it needs log (total_elements) entries.  Since total_elements has type
+   size_t, we get as upper bound for log (total_elements):
    bits per byte (CHAR_BIT) * sizeof(size_t).  */
 #define STACK_SIZE	(CHAR_BIT * sizeof (size_t))
-#define PUSH(low, high)	((void) ((top->lo = (low)), (top->hi = (high)), ++top))
-#define	POP(low, high)	((void) (--top, (low = top->lo), (high = top->hi)))
+#define PUSH(low, high, bad)						      \
+  ((void) ((top->lo = (low)), (top->hi = (high)),			      \
+	   (top->bad_allowed = (bad)), ++top))
+#define	POP(low, high, bad)						      \
+  ((void) (--top, (low = top->lo), (high = top->hi),			      \
+	   (bad = top->bad_allowed)))
 #define	STACK_NOT_EMPTY	(stack < top)
 
+/* All the helpers below are inlined into each specialization of
+   qsort_r_impl, so that SIZE is a constant for the word-sized swap
+   types.  The loops only rely on the comparison function to decide the
+   order of elements, never to stay within the array bounds, so an
+   inconsistent comparison function may produce an unsorted result but
+   no out-of-bounds accesses.  */
 
-/* Order size using quicksort.  This implementation incorporates
-   four optimizations discussed in Sedgewick:
+#define CMP(a, b) ((*cmp) ((void *) (a), (void *) (b), arg))
 
-   1. Non-recursive, using an explicit stack of pointer that store the
-      next array partition to sort.  To save time, this maximum amount
-      of space required to store an array of SIZE_MAX is allocated on the
-      stack.  Assuming a 32-bit (64 bit) integer for size_t, this needs
-      only 32 * sizeof(stack_node) == 256 bytes (for 64 bit: 1024 bytes).
-      Pretty cheap, actually.
+/* Sort the three elements at A, B and C.  */
+static inline __attribute__ ((always_inline)) void
+sort3 (char *a, char *b, char *c, size_t size, enum swap_type_t swap_type,
+       __compar_d_fn_t cmp, void *arg)
+{
+  if (CMP (b, a) < 0)
+    do_swap (a, b, size, swap_type);
+  if (CMP (c, b) < 0)
+    {
+      do_swap (b, c, size, swap_type);
+      if (CMP (b, a) < 0)
+	do_swap (a, b, size, swap_type);
+    }
+}
 
-   2. Chose the pivot element using a median-of-three decision tree.
-      This reduces the probability of selecting a bad pivot value and
-      eliminates certain extraneous comparisons.
+/* Sort [LO, HI) using insertion sort.  */
+static inline __attribute__ ((always_inline)) void
+insertion_sort (char *lo, char *hi, size_t size, enum swap_type_t swap_type,
+		__compar_d_fn_t cmp, void *arg)
+{
+  for (char *cur = lo + size; cur < hi; cur += size)
+    for (char *p = cur; p > lo && CMP (p, p - size) < 0; p -= size)
+      do_swap (p, p - size, size, swap_type);
+}
+
+/* Attempt to sort [LO, HI) using insertion sort.  Give up and return
+   false once more than PARTIAL_INSERTION_SORT_LIMIT elements have been
+   moved.  */
+static inline __attribute__ ((always_inline)) bool
+partial_insertion_sort (char *lo, char *hi, size_t size,
+			enum swap_type_t swap_type, __compar_d_fn_t cmp,
+			void *arg)
+{
+  size_t moves = 0;
 
-   3. Only quicksorts TOTAL_ELEMS / MAX_THRESH partitions, leaving
-      insertion sort to order the MAX_THRESH items within each partition.
-      This is a big win, since insertion sort is faster for small, mostly
-      sorted array segments.
+  for (char *cur = lo + size; cur < hi; cur += size)
+    {
+      for (char *p = cur; p > lo && CMP (p, p - size) < 0; p -= size)
+	{
+	  do_swap (p, p - size, size, swap_type);
+	  moves++;
+	}
+      if (moves > PARTIAL_INSERTION_SORT_LIMIT && cur + size < hi)
+	return false;
+    }
+  return true;
+}
 
-   4. The larger of the two sub-partitions is always pushed onto the
-      stack first, with the algorithm then concentrating on the
-      smaller partition.  This *guarantees* no more than log (total_elems)
-      stack size is needed (actually O(1) in this case)!  */
+/* Restore the heap property for the heap of N elements at BASE, whose
+   root is at index K.  */
+static inline __attribute__ ((always_inline)) void
+siftdown (char *base, size_t k, size_t n, size_t size,
+	  enum swap_type_t swap_type, __compar_d_fn_t cmp, void *arg)
+{
+  while (k < n / 2)
+    {
+      size_t j = 2 * k + 1;
+      if (j + 1 < n && CMP (base + j * size, base + (j + 1) * size) < 0)
+	j++;
+      if (CMP (base + j * size, base + k * size) <= 0)
+	break;
+      do_swap (base + j * size, base + k * size, size, swap_type);
+      k = j;
+    }
+}
 
-void
-_quicksort (void *const pbase, size_t total_elems, size_t size,
+/* Sort the N elements at BASE using heapsort.  Used for partitions for
+   which quicksort degenerates, to guarantee O(n log n) behavior.  */
+static inline __attribute__ ((always_inline)) void
+heapsort_r (char *base, size_t n, size_t size, enum swap_type_t swap_type,
 	    __compar_d_fn_t cmp, void *arg)
 {
-  char *base_ptr = (char *) pbase;
+  for (size_t k = n / 2; k > 0; k--)
+    siftdown (base, k - 1, n, size, swap_type, cmp, arg);
+
+  while (n > 1)
+    {
+      n--;
+      do_swap (base, base + n * size, size, swap_type);
+      siftdown (base, 0, n, size, swap_type, cmp, arg);
+    }
+}
+
+/* Partition [LO, HI) around the pivot at LO, into the elements less
+   than the pivot, the pivot, and the elements greater or equal to it.
+   Return the final position of the pivot.  Set *ALREADY_PARTITIONED if
+   no elements had to be swapped.  */
+static inline __attribute__ ((always_inline)) char *
+partition_right (char *lo, char *hi, size_t size, enum swap_type_t swap_type,
+		 __compar_d_fn_t cmp, void *arg, bool *already_partitioned)
+{
+  char *first = lo + size;
+  char *last = hi;
 
-  const size_t max_thresh = MAX_THRESH * size;
+  while (first < last && CMP (first, lo) < 0)
+    first += size;
+  while (first < last && CMP (last - size, lo) >= 0)
+    last -= size;
 
-  if (total_elems == 0)
-    /* Avoid lossage with unsigned arithmetic below.  */
-    return;
+  *already_partitioned = first >= last;
+
+  while (first < last)
+    {
+      do_swap (first, last - size, size, swap_type);
+      first += size;
+      last -= size;
+      while (first < last && CMP (first, lo) < 0)
+	first += size;
+      while (first < last && CMP (last - size, lo) >= 0)
+	last -= size;
+    }
+
+  char *pivot_pos = first - size;
+  if (pivot_pos != lo)
+    do_swap (lo, pivot_pos, size, swap_type);
+  return pivot_pos;
+}
+
+/* Like partition_right, but put the elements equal to the pivot on the
+   left.  This is used if the pivot is equal to the element before LO,
+   so that all the elements on the left are equal and need no further
+   sorting, which makes inputs with many duplicates sort in linear
+   time.  */
+static inline __attribute__ ((always_inline)) char *
+partition_left (char *lo, char *hi, size_t size, enum swap_type_t swap_type,
+		__compar_d_fn_t cmp, void *arg)
+{
+  char *first = lo + size;
+  char *last = hi;
+
+  while (first < last && CMP (lo, last - size) < 0)
+    last -= size;
+  while (first < last && CMP (lo, first) >= 0)
+    first += size;
 
-  if (total_elems > MAX_THRESH)
+  while (first < last)
+    {
+      do_swap (first, last - size, size, swap_type);
+      first += size;
+      last -= size;
+      while (first < last && CMP (lo, last - size) < 0)
+	last -= size;
+      while (first < last && CMP (lo, first) >= 0)
+	first += size;
+    }
+
+  char *pivot_pos = first - size;
+  if (pivot_pos != lo)
+    do_swap (lo, pivot_pos, size, swap_type);
+  return pivot_pos;
+}
+
+/* Order TOTAL_ELEMS elements of SIZE bytes at PBASE with a
+   pattern-defeating quicksort.  This is an introsort which in addition:
+
+   1. Chooses the pivot as the median of three elements, or of nine for
+      large partitions, and moves it to the start of the partition.
+
+   2. Puts the elements equal to the pivot of the enclosing partition on
+      one side, so that runs of equal elements are not sorted again.
+
+   3. Tries a bounded insertion sort on partitions which needed no swaps,
+      which makes sorted and nearly sorted inputs run in linear time.
+
+   4. Swaps some elements of partitions which were highly unbalanced, to
+      break up patterns which defeat the pivot selection, and switches
+      to heapsort after too many of them.
+
+   The larger partition is always pushed onto the stack and the smaller
+   one is processed first, so the stack depth is bounded by log
+   (total_elems).  No memory is allocated.  */
+static inline __attribute__ ((always_inline)) void
+qsort_r_impl (void *const pbase, size_t total_elems, size_t size,
+	      enum swap_type_t swap_type, __compar_d_fn_t cmp, void *arg)
+{
+  /* Make SIZE a constant for the specialized swap types.  */
+  if (swap_type == SWAP_WORDS_32)
+    size = sizeof (uint32_t);
+  else if (swap_type == SWAP_WORDS_64)
+    size = sizeof (uint64_t);
+  else if (swap_type == SWAP_WORDS_128)
+    size = 2 * sizeof (uint64_t);
+
+  char *base = pbase;
+  char *lo = base;
+  char *hi = base + size * total_elems;
+  int bad_allowed = 0;
+  for (size_t n = total_elems; n > 1; n >>= 1)
+    bad_allowed++;
+
+  stack_node stack[STACK_SIZE];
+  stack_node *top = stack;
+
+  while (1)
     {
-      char *lo = base_ptr;
-      char *hi = &lo[size * (total_elems - 1)];
-      stack_node stack[STACK_SIZE];
-      stack_node *top = stack;
-
-      PUSH (NULL, NULL);
-
-      while (STACK_NOT_EMPTY)
-        {
-          char *left_ptr;
-          char *right_ptr;
-
-	  /* Select median value from among LO, MID, and HI. Rearrange
-	     LO and HI so the three values are sorted. This lowers the
-	     probability of picking a pathological pivot value and
-	     skips a comparison for both the LEFT_PTR and RIGHT_PTR in
-	     the while loops. */
-
-	  char *mid = lo + size * ((hi - lo) / size >> 1);
-
-	  if ((*cmp) ((void *) mid, (void *) lo, arg) < 0)
-	    SWAP (mid, lo, size);
-	  if ((*cmp) ((void *) hi, (void *) mid, arg) < 0)
-	    SWAP (mid, hi, size);
+      size_t n = (hi - lo) / size;
+
+      if (n <= INSERTION_SORT_THRESHOLD || bad_allowed <= 0)
+	{
+	  if (n <= INSERTION_SORT_THRESHOLD)
+	    insertion_sort (lo, hi, size, swap_type, cmp, arg);
 	  else
-	    goto jump_over;
-	  if ((*cmp) ((void *) mid, (void *) lo, arg) < 0)
-	    SWAP (mid, lo, size);
-	jump_over:;
-
-	  left_ptr  = lo + size;
-	  right_ptr = hi - size;
-
-	  /* Here's the famous ``collapse the walls'' section of quicksort.
-	     Gotta like those tight inner loops!  They are the main reason
-	     that this algorithm runs much faster than others. */
-	  do
+	    heapsort_r (lo, n, size, swap_type, cmp, arg);
+
+	  if (!STACK_NOT_EMPTY)
+	    break;
+	  POP (lo, hi, bad_allowed);
+	  continue;
+	}
+
+      /* Select the pivot and move it to LO.  */
+      char *mid = lo + size * (n / 2);
+      if (n > NINTHER_THRESHOLD)
+	{
+	  sort3 (lo, mid, hi - size, size, swap_type, cmp, arg);
+	  sort3 (lo + size, mid - size, hi - 2 * size, size, swap_type,
+		 cmp, arg);
+	  sort3 (lo + 2 * size, mid + size, hi - 3 * size, size, swap_type,
+		 cmp, arg);
+	  sort3 (mid - size, mid, mid + size, size, swap_type, cmp, arg);
+	  do_swap (lo, mid, size, swap_type);
+	}
+      else
+	sort3 (mid, lo, hi - size, size, swap_type, cmp, arg);
+
+      /* If the pivot is equal to the element before the partition, which
+	 is less than or equal to all elements of the partition, there is
+	 no need to sort the elements equal to the pivot.  */
+      if (lo != base && CMP (lo - size, lo) >= 0)
+	{
+	  lo = partition_left (lo, hi, size, swap_type, cmp, arg) + size;
+	  continue;
+	}
+
+      bool already_partitioned;
+      char *pivot_pos = partition_right (lo, hi, size, swap_type, cmp, arg,
+					 &already_partitioned);
+      size_t l_size = (pivot_pos - lo) / size;
+      size_t r_size = (hi - pivot_pos) / size - 1;
+
+      if (l_size < n / 8 || r_size < n / 8)
+	{
+	  /* The partition is highly unbalanced.  Swap some elements to
+	     break up a pattern in the input.  */
+	  if (--bad_allowed <= 0)
 	    {
-	      while ((*cmp) ((void *) left_ptr, (void *) mid, arg) < 0)
-		left_ptr += size;
-
-	      while ((*cmp) ((void *) mid, (void *) right_ptr, arg) < 0)
-		right_ptr -= size;
+	      /* Switch to heapsort for this partition on the next
+		 iteration.  */
+	      continue;
+	    }
 
-	      if (left_ptr < right_ptr)
+	  if (l_size >= INSERTION_SORT_THRESHOLD)
+	    {
+	      size_t q = size * (l_size / 4);
+	      do_swap (lo, lo + q, size, swap_type);
+	      do_swap (pivot_pos - size, pivot_pos - q, size, swap_type);
+	      if (l_size > NINTHER_THRESHOLD)
 		{
-		  SWAP (left_ptr, right_ptr, size);
-		  if (mid == left_ptr)
-		    mid = right_ptr;
-		  else if (mid == right_ptr)
-		    mid = left_ptr;
-		  left_ptr += size;
-		  right_ptr -= size;
+		  /* Also move the other elements used by the ninther.  */
+		  do_swap (lo + size, lo + q + size, size, swap_type);
+		  do_swap (lo + 2 * size, lo + q + 2 * size, size, swap_type);
+		  do_swap (pivot_pos - 2 * size, pivot_pos - q - size, size,
+			   swap_type);
+		  do_swap (pivot_pos - 3 * size, pivot_pos - q - 2 * size,
+			   size, swap_type);
 		}
-	      else if (left_ptr == right_ptr)
+	    }
+	  if (r_size >= INSERTION_SORT_THRESHOLD)
+	    {
+	      char *r_lo = pivot_pos + size;
+	      size_t q = size * (r_size / 4);
+	      do_swap (r_lo, r_lo + q, size, swap_type);
+	      do_swap (hi - size, hi - q, size, swap_type);
+	      if (r_size > NINTHER_THRESHOLD)
 		{
-		  left_ptr += size;
-		  right_ptr -= size;
-		  break;
+		  do_swap (r_lo + size, r_lo + q + size, size, swap_type);
+		  do_swap (r_lo + 2 * size, r_lo + q + 2 * size, size,
+			   swap_type);
+		  do_swap (hi - 2 * size, hi - q - size, size, swap_type);
+		  do_swap (hi - 3 * size, hi - q - 2 * size, size, swap_type);
 		}
 	    }
-	  while (left_ptr <= right_ptr);
-
-          /* Set up pointers for next iteration.  First determine whether
-             left and right partitions are below the threshold size.  If so,
-             ignore one or both.  Otherwise, push the larger partition's
-             bounds on the stack and continue sorting the smaller one. */
-
-          if ((size_t) (right_ptr - lo) <= max_thresh)
-            {
-              if ((size_t) (hi - left_ptr) <= max_thresh)
-		/* Ignore both small partitions. */
-                POP (lo, hi);
-              else
-		/* Ignore small left partition. */
-                lo = left_ptr;
-            }
-          else if ((size_t) (hi - left_ptr) <= max_thresh)
-	    /* Ignore small right partition. */
-            hi = right_ptr;
-          else if ((right_ptr - lo) > (hi - left_ptr))
-            {
-	      /* Push larger left partition indices. */
-              PUSH (lo, right_ptr);
-              lo = left_ptr;
-            }
-          else
-            {
-	      /* Push larger right partition indices. */
-              PUSH (left_ptr, hi);
-              hi = right_ptr;
-            }
-        }
+	}
+      else if (already_partitioned
+	       && partial_insertion_sort (lo, pivot_pos, size, swap_type,
+					  cmp, arg)
+	       && partial_insertion_sort (pivot_pos + size, hi, size,
+					  swap_type, cmp, arg))
+	{
+	  /* Both partitions were (nearly) sorted already.  */
+	  if (!STACK_NOT_EMPTY)
+	    break;
+	  POP (lo, hi, bad_allowed);
+	  continue;
+	}
+
+      /* Push the larger partition and continue with the smaller one.  */
+      if (l_size > r_size)
+	{
+	  PUSH (lo, pivot_pos, bad_allowed);
+	  lo = pivot_pos + size;
+	}
+      else
+	{
+	  PUSH (pivot_pos + size, hi, bad_allowed);
+	  hi = pivot_pos;
+	}
     }
+}
 
-  /* Once the BASE_PTR array is partially sorted by quicksort the rest
-     is completely sorted using insertion sort, since this is efficient
-     for partitions below MAX_THRESH size. BASE_PTR points to the beginning
-     of the array to sort, and END_PTR points at the very last element in
-     the array (*not* one beyond it!). */
-
-#define min(x, y) ((x) < (y) ? (x) : (y))
-
-  {
-    char *const end_ptr = &base_ptr[size * (total_elems - 1)];
-    char *tmp_ptr = base_ptr;
-    char *thresh = min(end_ptr, base_ptr + max_thresh);
-    char *run_ptr;
-
-    /* Find smallest element in first threshold and place it at the
-       array's beginning.  This is the smallest array element,
-       and the operation speeds up insertion sort's inner loop. */
-
-    for (run_ptr = tmp_ptr + size; run_ptr <= thresh; run_ptr += size)
-      if ((*cmp) ((void *) run_ptr, (void *) tmp_ptr, arg) < 0)
-        tmp_ptr = run_ptr;
+void
+__qsort_r (void *const pbase, size_t total_elems, size_t size,
+	   __compar_d_fn_t cmp, void *arg)
+{
+  if (total_elems <= 1 || size == 0)
+    return;
 
-    if (tmp_ptr != base_ptr)
-      SWAP (tmp_ptr, base_ptr, size);
+  switch (get_swap_type (pbase, size))
+    {
+    case SWAP_WORDS_32:
+      qsort_r_impl (pbase, total_elems, size, SWAP_WORDS_32, cmp, arg);
+      break;
+    case SWAP_WORDS_64:
+      qsort_r_impl (pbase, total_elems, size, SWAP_WORDS_64, cmp, arg);
+      break;
+    case SWAP_WORDS_128:
+      qsort_r_impl (pbase, total_elems, size, SWAP_WORDS_128, cmp, arg);
+      break;
+    default:
+      qsort_r_impl (pbase, total_elems, size, SWAP_BYTES, cmp, arg);
+    }
+}
+libc_hidden_def (__qsort_r)
+weak_alias (__qsort_r, qsort_r)
 
-    /* Insertion sort, running from left-hand-side up to right-hand-side.  */
 
-    run_ptr = base_ptr + size;
-    while ((run_ptr += size) <= end_ptr)
-      {
-	tmp_ptr = run_ptr - size;
-	while ((*cmp) ((void *) run_ptr, (void *) tmp_ptr, arg) < 0)
-	  tmp_ptr -= size;
-
-	tmp_ptr += size;
-        if (tmp_ptr != run_ptr)
-          {
-            char *trav;
-
-	    trav = run_ptr + size;
-	    while (--trav >= run_ptr)
-              {
-                char c = *trav;
-                char *hi, *lo;
-
-                for (hi = lo = trav; (lo -= size) >= tmp_ptr; hi = lo)
-                  *hi = *lo;
-                *hi = c;
-              }
-          }
-      }
-  }
+void
+qsort (void *b, size_t n, size_t s, __compar_fn_t cmp)
+{
+  return __qsort_r (b, n, s, (__compar_d_fn_t) cmp, NULL);
 }
+libc_hidden_def (qsort)
@@ -158,6 +158,16 @@ extern FLOAT MPN2FLOAT (mp_srcptr mpn, int exponent, int negative);
 #endif
 
 extern const mp_limb_t _tens_in_limb[MAX_DIG_PER_LIMB + 1];
+
+/* The Eisel-Lemire fast path is used for the float and double formats,
+   for numbers with at most 19 significant digits.  */
+#if MANT_DIG == 24 || MANT_DIG == 53
+# include "eisel-lemire.h"
+# define USE_EISEL_LEMIRE	1
+# define MAX_EISEL_LEMIRE_DIG	19
+#else
+# define USE_EISEL_LEMIRE	0
+#endif
 
 #ifndef	howmany
 #define	howmany(x,y)		(((x)+((y)-1))/(y))
@@ -1192,6 +1202,42 @@ ____STRTOF_INTERNAL (const STRING_TYPE *nptr, STRING_TYPE **endptr, int group,
   if (__glibc_unlikely (exponent < MIN_10_EXP - (DIG + 2)))
     return underflow_value (negative);
 
+#if USE_EISEL_LEMIRE
+  /* Most decimal numbers in practice have few enough digits to fit in
+     64 bits.  Try to convert them without multi-precision arithmetic,
+     which gives the result for all but very rare inputs if the result
+     is a normal number.  The algorithm only rounds to nearest.  */
+  if (dig_no <= MAX_EISEL_LEMIRE_DIG && get_rounding_mode () == FE_TONEAREST)
+    {
+      uint64_t w = 0;
+      const STRING_TYPE *dp = startp;
+      /* Skip the radix character and the thousands separators.  */
+      for (size_t i = 0; i < dig_no; ++dp)
+	if (*dp >= L_('0') && *dp <= L_('9'))
+	  {
+	    w = w * 10 + *dp - L_('0');
+	    ++i;
+	  }
+
+      uint64_t mantissa;
+      int bin_exp;
+      bool exact;
+      if (eisel_lemire (w, exponent + (intmax_t) int_no - (intmax_t) dig_no,
+			MANT_DIG, MAX_EXP, &mantissa, &bin_exp, &exact))
+	{
+	  /* Raise the inexact exception like round_and_return.  */
+	  if (!exact)
+	    {
+	      FLOAT force_inexact = (FLOAT) 1 + MIN_VALUE;
+	      math_force_eval (force_inexact);
+	    }
+	  for (int i = 0; i < RETURN_LIMB_SIZE; ++i)
+	    retval[i] = mantissa >> (i * BITS_PER_MP_LIMB);
+	  return MPN2FLOAT (retval, bin_exp, negative);
+	}
+    }
+#endif
+
   if (int_no > 0)
     {
       /* Read the integer part as a multi-precision number to NUM.  */
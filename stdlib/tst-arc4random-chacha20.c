@@ -0,0 +1,74 @@
+/* Basic tests for the ChaCha20 implementation used by arc4random.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <chacha20.c>
+#include <support/check.h>
+
+static int
+do_test (void)
+{
+  /* Test vector from RFC 8439, section 2.3.2: the key is the bytes 0 to
+     31, the block counter is 1 and the nonce is
+     00:00:00:09:00:00:00:4a:00:00:00:00.  */
+  uint8_t key[CHACHA20_KEY_SIZE];
+  for (int i = 0; i < sizeof (key); i++)
+    key[i] = i;
+  const uint8_t iv[CHACHA20_IV_SIZE] =
+    {
+      0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09,
+      0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00
+    };
+  const uint8_t expected[CHACHA20_BLOCK_SIZE] =
+    {
+      0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15,
+      0x50, 0x0f, 0xdd, 0x1f, 0xa3, 0x20, 0x71, 0xc4,
+      0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0, 0x68, 0x03,
+      0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e,
+      0xd2, 0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09,
+      0x14, 0xc2, 0xd7, 0x05, 0xd9, 0x8b, 0x02, 0xa2,
+      0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e, 0xb9,
+      0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e
+    };
+
+  uint32_t state[CHACHA20_STATE_LEN];
+  uint8_t output[2 * CHACHA20_BUFSIZE];
+
+  chacha20_init (state, key, iv);
+  chacha20_blocks (state, output);
+  TEST_COMPARE_BLOB (output, CHACHA20_BLOCK_SIZE,
+		     expected, CHACHA20_BLOCK_SIZE);
+  TEST_COMPARE (state[12], 1 + CHACHA20_BLOCKS);
+
+  /* The keystream continues where the previous call left off, and the
+     blocks computed in parallel match those computed one at a time.  */
+  chacha20_blocks (state, output + CHACHA20_BUFSIZE);
+  for (int i = 1; i < 2 * CHACHA20_BLOCKS; i++)
+    {
+      uint32_t single[CHACHA20_STATE_LEN];
+      uint8_t block[CHACHA20_BUFSIZE];
+      chacha20_init (single, key, iv);
+      single[12] += i;
+      chacha20_blocks (single, block);
+      TEST_COMPARE_BLOB (output + i * CHACHA20_BLOCK_SIZE,
+			 CHACHA20_BLOCK_SIZE, block, CHACHA20_BLOCK_SIZE);
+    }
+
+  return 0;
+}
+
+#include <support/test-driver.c>
@@ -0,0 +1,190 @@
+/* qsort test with different element sizes and input patterns.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <array_length.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <support/check.h>
+#include <support/support.h>
+
+typedef enum
+  {
+    Sorted,
+    Reversed,
+    Random,
+    FewDistinct,
+    NearlySorted,
+    OrganPipe,
+  } arraytype_t;
+
+static const char *const arraytype_names[] =
+  {
+    "sorted", "reversed", "random", "few-distinct", "nearly-sorted",
+    "organ-pipe"
+  };
+
+/* Element sizes covering the specialized swaps (4, 8 and 16 bytes) and
+   the generic one.  */
+static const size_t element_sizes[] = { 4, 5, 8, 12, 16, 24, 33, 100 };
+
+static const size_t element_counts[] =
+  {
+    0, 1, 2, 3, 4, 7, 15, 16, 17, 31, 64, 127, 128, 129, 1000, 4096, 30001
+  };
+
+/* Each element starts with a 32-bit key.  The remaining bytes are
+   derived from the key so that a check can detect elements which have
+   been mixed up by the swaps.  */
+static uint32_t
+get_key (const unsigned char *p)
+{
+  uint32_t key;
+  memcpy (&key, p, sizeof (key));
+  return key;
+}
+
+static void
+set_element (unsigned char *p, size_t size, uint32_t key)
+{
+  memcpy (p, &key, sizeof (key));
+  for (size_t i = sizeof (key); i < size; i++)
+    p[i] = key ^ i;
+}
+
+static int
+compare_key (const void *a, const void *b)
+{
+  uint32_t ka = get_key (a);
+  uint32_t kb = get_key (b);
+  return (ka > kb) - (ka < kb);
+}
+
+static void
+fill_array (unsigned char *array, size_t nmemb, size_t size,
+	    arraytype_t type)
+{
+  for (size_t i = 0; i < nmemb; i++)
+    {
+      uint32_t key;
+      switch (type)
+	{
+	case Sorted:
+	  key = i;
+	  break;
+	case Reversed:
+	  key = nmemb - i;
+	  break;
+	case Random:
+	  key = random ();
+	  break;
+	case FewDistinct:
+	  key = random () % 4;
+	  break;
+	case NearlySorted:
+	  key = i % 100 == 0 ? random () : i;
+	  break;
+	case OrganPipe:
+	  key = i < nmemb / 2 ? i : nmemb - i;
+	  break;
+	default:
+	  abort ();
+	}
+      set_element (array + i * size, size, key);
+    }
+}
+
+static void
+check_array (const unsigned char *array, size_t nmemb, size_t size,
+	     uint64_t key_sum, arraytype_t type)
+{
+  uint64_t sum = 0;
+  for (size_t i = 0; i < nmemb; i++)
+    {
+      const unsigned char *p = array + i * size;
+      uint32_t key = get_key (p);
+      sum += key;
+      for (size_t j = sizeof (key); j < size; j++)
+	if (p[j] != (unsigned char) (key ^ j))
+	  FAIL_EXIT1 ("%s, %zu x %zu: element %zu corrupted",
+		      arraytype_names[type], nmemb, size, i);
+      if (i > 0 && get_key (p - size) > key)
+	FAIL_EXIT1 ("%s, %zu x %zu: not sorted at element %zu",
+		    arraytype_names[type], nmemb, size, i);
+    }
+  if (sum != key_sum)
+    FAIL_EXIT1 ("%s, %zu x %zu: elements lost",
+		arraytype_names[type], nmemb, size);
+}
+
+/* A comparison function which is not consistent.  qsort may produce
+   any order with it, but must not access elements outside of the
+   array.  */
+static int
+compare_random (const void *a, const void *b)
+{
+  return random () % 3 - 1;
+}
+
+static void
+test_one (unsigned char *array, size_t nmemb, size_t size, arraytype_t type)
+{
+  fill_array (array, nmemb, size, type);
+  uint64_t key_sum = 0;
+  for (size_t i = 0; i < nmemb; i++)
+    key_sum += get_key (array + i * size);
+
+  qsort (array, nmemb, size, compare_key);
+  check_array (array, nmemb, size, key_sum, type);
+}
+
+static int
+do_test (void)
+{
+  srandom (1);
+
+  for (size_t s = 0; s < array_length (element_sizes); s++)
+    for (size_t n = 0; n < array_length (element_counts); n++)
+      for (arraytype_t type = Sorted; type <= OrganPipe; type++)
+	{
+	  size_t size = element_sizes[s];
+	  size_t nmemb = element_counts[n];
+	  unsigned char *array = xmalloc (nmemb * size + 1);
+
+	  test_one (array, nmemb, size, type);
+	  /* Also check unaligned arrays, which use the generic swap.  */
+	  test_one (array + 1, nmemb, size, type);
+
+	  free (array);
+	}
+
+  for (size_t s = 0; s < array_length (element_sizes); s++)
+    {
+      size_t size = element_sizes[s];
+      size_t nmemb = 4096;
+      unsigned char *array = xmalloc (nmemb * size);
+      fill_array (array, nmemb, size, Random);
+      qsort (array, nmemb, size, compare_random);
+      free (array);
+    }
+
+  return 0;
+}
+
+#include <support/test-driver.c>
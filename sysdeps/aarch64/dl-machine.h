@@ -26,9 +26,13 @@
 #include <dl-tlsdesc.h>
 #include <dl-static-tls.h>
 #include <dl-irel.h>
+#include <dl-ifunc-cache.h>
 #include <dl-machine-rel.h>
 #include <cpu-features.c>
 
+/* The relocation code below uses elf_ifunc_invoke_cached.  */
+#define ELF_MACHINE_IFUNC_CACHE 1
+
 /* Translate a processor specific dynamic tag to the index in l_info array.  */
 #define DT_AARCH64(x) (DT_AARCH64_##x - DT_LOPROC + DT_NUM)
 
@@ -189,7 +193,7 @@ elf_machine_rela (struct link_map *map, struct r_scope_elem *scope[],
 	  && __glibc_unlikely (ELFW(ST_TYPE) (sym->st_info) == STT_GNU_IFUNC)
 	  && __glibc_likely (sym->st_shndx != SHN_UNDEF)
 	  && __glibc_likely (!skip_ifunc))
-	value = elf_ifunc_invoke (value);
+	value = elf_ifunc_invoke_cached (sym_map, value);
 
       switch (r_type)
 	{
@@ -279,7 +283,7 @@ elf_machine_rela (struct link_map *map, struct r_scope_elem *scope[],
 	case AARCH64_R(IRELATIVE):
 	  value = map->l_addr + reloc->r_addend;
 	  if (__glibc_likely (!skip_ifunc))
-	    value = elf_ifunc_invoke (value);
+	    value = elf_ifunc_invoke_cached (map, value);
 	  *reloc_addr = value;
 	  break;
 # endif /* !RTLD_BOOTSTRAP */
@@ -364,7 +368,7 @@ elf_machine_lazy_rel (struct link_map *map, struct r_scope_elem *scope[],
     {
       ElfW(Addr) value = map->l_addr + reloc->r_addend;
       if (__glibc_likely (!skip_ifunc))
-	value = elf_ifunc_invoke (value);
+	value = elf_ifunc_invoke_cached (map, value);
       *reloc_addr = value;
     }
   else
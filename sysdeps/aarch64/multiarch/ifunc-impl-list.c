@@ -61,6 +61,19 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 	      IFUNC_IMPL_ADD (array, i, memset, sve && zva_size == 256, __memset_a64fx)
 #endif
 	      IFUNC_IMPL_ADD (array, i, memset, 1, __memset_generic))
+  IFUNC_IMPL (i, name, memcmp,
+#if HAVE_AARCH64_SVE_ASM
+	      IFUNC_IMPL_ADD (array, i, memcmp, sve, __memcmp_sve)
+#endif
+	      IFUNC_IMPL_ADD (array, i, memcmp, 1, __memcmp_generic))
+  IFUNC_IMPL (i, name, memrchr,
+#if HAVE_AARCH64_SVE_ASM
+	      IFUNC_IMPL_ADD (array, i, memrchr, sve, __memrchr_sve)
+#endif
+	      IFUNC_IMPL_ADD (array, i, memrchr, 1, __memrchr_generic))
+  IFUNC_IMPL (i, name, memmem,
+	      IFUNC_IMPL_ADD (array, i, memmem, 1, __memmem_asimd)
+	      IFUNC_IMPL_ADD (array, i, memmem, 1, __memmem_generic))
   IFUNC_IMPL (i, name, memchr,
 	      IFUNC_IMPL_ADD (array, i, memchr, !mte, __memchr_nosimd)
 	      IFUNC_IMPL_ADD (array, i, memchr, 1, __memchr_generic))
@@ -69,5 +82,35 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 	      IFUNC_IMPL_ADD (array, i, strlen, !mte, __strlen_asimd)
 	      IFUNC_IMPL_ADD (array, i, strlen, 1, __strlen_mte))
 
+  IFUNC_IMPL (i, name, strchr,
+#if HAVE_AARCH64_SVE_ASM
+	      IFUNC_IMPL_ADD (array, i, strchr, sve, __strchr_sve)
+#endif
+	      IFUNC_IMPL_ADD (array, i, strchr, 1, __strchr_generic))
+
+  IFUNC_IMPL (i, name, strrchr,
+#if HAVE_AARCH64_SVE_ASM
+	      IFUNC_IMPL_ADD (array, i, strrchr, sve, __strrchr_sve)
+#endif
+	      IFUNC_IMPL_ADD (array, i, strrchr, 1, __strrchr_generic))
+
+  IFUNC_IMPL (i, name, strcmp,
+#if HAVE_AARCH64_SVE_ASM
+	      IFUNC_IMPL_ADD (array, i, strcmp, sve, __strcmp_sve)
+#endif
+	      IFUNC_IMPL_ADD (array, i, strcmp, 1, __strcmp_generic))
+
+  IFUNC_IMPL (i, name, strcpy,
+#if HAVE_AARCH64_SVE_ASM
+	      IFUNC_IMPL_ADD (array, i, strcpy, sve, __strcpy_sve)
+#endif
+	      IFUNC_IMPL_ADD (array, i, strcpy, 1, __strcpy_generic))
+
+  IFUNC_IMPL (i, name, stpcpy,
+#if HAVE_AARCH64_SVE_ASM
+	      IFUNC_IMPL_ADD (array, i, stpcpy, sve, __stpcpy_sve)
+#endif
+	      IFUNC_IMPL_ADD (array, i, stpcpy, 1, __stpcpy_generic))
+
   return 0;
 }
@@ -0,0 +1,112 @@
+/* SHA256 block function using the ARMv8 SHA2 instructions.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <arm_neon.h>
+#include <endian.h>
+#include <stdint.h>
+#include <crypt/sha256.h>
+
+/* Constants for SHA256 from FIPS 180-2:4.2.2.  */
+static const uint32_t K[64] =
+  {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+static inline uint32x4_t
+load_words (const uint32_t *p)
+{
+  uint32x4_t w = vld1q_u32 (p);
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+  w = vreinterpretq_u32_u8 (vrev32q_u8 (vreinterpretq_u8_u32 (w)));
+#endif
+  return w;
+}
+
+/* Process LEN bytes of BUFFER, accumulating context into CTX.
+   It is assumed that LEN % 64 == 0.
+
+   SHA256H and SHA256H2 perform four rounds at a time on the state
+   split into ABCD and EFGH.  SHA256SU0 and SHA256SU1 compute the
+   message schedule (FIPS 180-2:6.2.2 step 2) four words at a time.  */
+void
+__sha256_process_block_sha2 (const void *buffer, size_t len,
+			     struct sha256_ctx *ctx)
+{
+  const uint32_t *words = buffer;
+  size_t nwords = len / sizeof (uint32_t);
+  uint32x4_t abcd = vld1q_u32 (&ctx->H[0]);
+  uint32x4_t efgh = vld1q_u32 (&ctx->H[4]);
+
+  /* First increment the byte count.  FIPS 180-2 specifies the possible
+     length of the file up to 2^64 bits.  Here we only compute the
+     number of bytes.  */
+  ctx->total64 += len;
+
+  while (nwords > 0)
+    {
+      uint32x4_t abcd_save = abcd;
+      uint32x4_t efgh_save = efgh;
+      uint32x4_t m[4];
+
+      for (unsigned int g = 0; g < 4; ++g)
+	m[g] = load_words (&words[4 * g]);
+
+      for (unsigned int g = 0; g < 16; ++g)
+	{
+	  uint32x4_t wk = vaddq_u32 (m[g & 3], vld1q_u32 (&K[4 * g]));
+
+	  /* Replace the current group by the one four groups ahead.  */
+	  if (g < 12)
+	    m[g & 3] = vsha256su1q_u32 (vsha256su0q_u32 (m[g & 3],
+							 m[(g + 1) & 3]),
+					m[(g + 2) & 3], m[(g + 3) & 3]);
+
+	  uint32x4_t abcd_prev = abcd;
+	  abcd = vsha256hq_u32 (abcd, efgh, wk);
+	  efgh = vsha256h2q_u32 (efgh, abcd_prev, wk);
+	}
+
+      /* Add the starting values of the context according to FIPS 180-2:6.2.2
+	 step 4.  */
+      abcd = vaddq_u32 (abcd, abcd_save);
+      efgh = vaddq_u32 (efgh, efgh_save);
+
+      /* Prepare for the next round.  */
+      words += 16;
+      nwords -= 16;
+    }
+
+  /* Put checksum in context given as argument.  */
+  vst1q_u32 (&ctx->H[0], abcd);
+  vst1q_u32 (&ctx->H[4], efgh);
+}
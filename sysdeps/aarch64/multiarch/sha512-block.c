@@ -0,0 +1,40 @@
+/* Multiple versions of the SHA512 block function.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <stdint.h>
+#include <sys/auxv.h>
+
+#define __sha512_process_block __sha512_process_block_generic
+extern void __sha512_process_block_generic (const void *buffer, size_t len,
+					    struct sha512_ctx *ctx);
+
+#include <crypt/sha512-block.c>
+
+#undef __sha512_process_block
+
+extern void __sha512_process_block_sha512 (const void *buffer, size_t len,
+					   struct sha512_ctx *ctx);
+
+/* The resolver takes the hardware capabilities from its argument
+   rather than from GLRO(dl_hwcap), which is not available when this
+   file is linked into the sha512test program.  */
+#define SHA512_INIT_ARCH()
+__ifunc (__sha512_process_block, __sha512_process_block,
+	 (hwcap & HWCAP_SHA512)
+	 ? __sha512_process_block_sha512 : __sha512_process_block_generic,
+	 uint64_t hwcap, SHA512_INIT_ARCH)
@@ -0,0 +1,168 @@
+/* SHA512 block function using the ARMv8.2 SHA512 instructions.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <arm_neon.h>
+#include <endian.h>
+#include <stdint.h>
+#include <crypt/sha512.h>
+
+/* Constants for SHA512 from FIPS 180-2:4.2.3.  */
+static const uint64_t K[80] =
+  {
+    UINT64_C (0x428a2f98d728ae22), UINT64_C (0x7137449123ef65cd),
+    UINT64_C (0xb5c0fbcfec4d3b2f), UINT64_C (0xe9b5dba58189dbbc),
+    UINT64_C (0x3956c25bf348b538), UINT64_C (0x59f111f1b605d019),
+    UINT64_C (0x923f82a4af194f9b), UINT64_C (0xab1c5ed5da6d8118),
+    UINT64_C (0xd807aa98a3030242), UINT64_C (0x12835b0145706fbe),
+    UINT64_C (0x243185be4ee4b28c), UINT64_C (0x550c7dc3d5ffb4e2),
+    UINT64_C (0x72be5d74f27b896f), UINT64_C (0x80deb1fe3b1696b1),
+    UINT64_C (0x9bdc06a725c71235), UINT64_C (0xc19bf174cf692694),
+    UINT64_C (0xe49b69c19ef14ad2), UINT64_C (0xefbe4786384f25e3),
+    UINT64_C (0x0fc19dc68b8cd5b5), UINT64_C (0x240ca1cc77ac9c65),
+    UINT64_C (0x2de92c6f592b0275), UINT64_C (0x4a7484aa6ea6e483),
+    UINT64_C (0x5cb0a9dcbd41fbd4), UINT64_C (0x76f988da831153b5),
+    UINT64_C (0x983e5152ee66dfab), UINT64_C (0xa831c66d2db43210),
+    UINT64_C (0xb00327c898fb213f), UINT64_C (0xbf597fc7beef0ee4),
+    UINT64_C (0xc6e00bf33da88fc2), UINT64_C (0xd5a79147930aa725),
+    UINT64_C (0x06ca6351e003826f), UINT64_C (0x142929670a0e6e70),
+    UINT64_C (0x27b70a8546d22ffc), UINT64_C (0x2e1b21385c26c926),
+    UINT64_C (0x4d2c6dfc5ac42aed), UINT64_C (0x53380d139d95b3df),
+    UINT64_C (0x650a73548baf63de), UINT64_C (0x766a0abb3c77b2a8),
+    UINT64_C (0x81c2c92e47edaee6), UINT64_C (0x92722c851482353b),
+    UINT64_C (0xa2bfe8a14cf10364), UINT64_C (0xa81a664bbc423001),
+    UINT64_C (0xc24b8b70d0f89791), UINT64_C (0xc76c51a30654be30),
+    UINT64_C (0xd192e819d6ef5218), UINT64_C (0xd69906245565a910),
+    UINT64_C (0xf40e35855771202a), UINT64_C (0x106aa07032bbd1b8),
+    UINT64_C (0x19a4c116b8d2d0c8), UINT64_C (0x1e376c085141ab53),
+    UINT64_C (0x2748774cdf8eeb99), UINT64_C (0x34b0bcb5e19b48a8),
+    UINT64_C (0x391c0cb3c5c95a63), UINT64_C (0x4ed8aa4ae3418acb),
+    UINT64_C (0x5b9cca4f7763e373), UINT64_C (0x682e6ff3d6b2b8a3),
+    UINT64_C (0x748f82ee5defb2fc), UINT64_C (0x78a5636f43172f60),
+    UINT64_C (0x84c87814a1f0ab72), UINT64_C (0x8cc702081a6439ec),
+    UINT64_C (0x90befffa23631e28), UINT64_C (0xa4506cebde82bde9),
+    UINT64_C (0xbef9a3f7b2c67915), UINT64_C (0xc67178f2e372532b),
+    UINT64_C (0xca273eceea26619c), UINT64_C (0xd186b8c721c0c207),
+    UINT64_C (0xeada7dd6cde0eb1e), UINT64_C (0xf57d4f7fee6ed178),
+    UINT64_C (0x06f067aa72176fba), UINT64_C (0x0a637dc5a2c898a6),
+    UINT64_C (0x113f9804bef90dae), UINT64_C (0x1b710b35131c471b),
+    UINT64_C (0x28db77f523047d84), UINT64_C (0x32caab7b40c72493),
+    UINT64_C (0x3c9ebe0a15c9bebc), UINT64_C (0x431d67c49c100d4c),
+    UINT64_C (0x4cc5d4becb3e42b6), UINT64_C (0x597f299cfc657e2a),
+    UINT64_C (0x5fcb6fab3ad6faec), UINT64_C (0x6c44198c4a475817)
+  };
+
+static inline uint64x2_t
+load_words (const uint64_t *p)
+{
+  uint64x2_t w = vld1q_u64 (p);
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+  w = vreinterpretq_u64_u8 (vrev64q_u8 (vreinterpretq_u8_u64 (w)));
+#endif
+  return w;
+}
+
+/* Process LEN bytes of BUFFER, accumulating context into CTX.
+   It is assumed that LEN % 128 == 0.
+
+   The state is kept in the register pairs AB, CD, EF and GH plus one
+   spare.  SHA512H and SHA512H2 perform two rounds at a time, after
+   which the pair which received the new E and F is the one which held
+   the old G and H; the names are rotated instead of moving the
+   registers.  SHA512SU0 and SHA512SU1 compute the message schedule
+   (FIPS 180-2:6.2.2 step 2) two words at a time.  */
+void
+__sha512_process_block_sha512 (const void *buffer, size_t len,
+			       struct sha512_ctx *ctx)
+{
+  const uint64_t *words = buffer;
+  size_t nwords = len / sizeof (uint64_t);
+  uint64x2_t ab = vld1q_u64 (&ctx->H[0]);
+  uint64x2_t cd = vld1q_u64 (&ctx->H[2]);
+  uint64x2_t ef = vld1q_u64 (&ctx->H[4]);
+  uint64x2_t gh = vld1q_u64 (&ctx->H[6]);
+
+  /* First increment the byte count.  FIPS 180-2 specifies the possible
+     length of the file up to 2^128 bits.  Here we only compute the
+     number of bytes.  Do a double word increment.  */
+#ifdef USE_TOTAL128
+  ctx->total128 += len;
+#else
+  uint64_t lolen = len;
+  ctx->total[TOTAL128_low] += lolen;
+  ctx->total[TOTAL128_high] += ((len >> 31 >> 31 >> 2)
+				+ (ctx->total[TOTAL128_low] < lolen));
+#endif
+
+  while (nwords > 0)
+    {
+      uint64x2_t s0 = ab;
+      uint64x2_t s1 = cd;
+      uint64x2_t s2 = ef;
+      uint64x2_t s3 = gh;
+      uint64x2_t s4;
+      uint64x2_t m[8];
+
+      for (unsigned int g = 0; g < 8; ++g)
+	m[g] = load_words (&words[2 * g]);
+
+      for (unsigned int g = 0; g < 40; ++g)
+	{
+	  uint64x2_t wk = vaddq_u64 (m[g & 7], vld1q_u64 (&K[2 * g]));
+	  uint64x2_t fg = vextq_u64 (s2, s3, 1);
+	  uint64x2_t de = vextq_u64 (s1, s2, 1);
+
+	  /* Replace the current group by the one eight groups ahead.  */
+	  if (g < 32)
+	    m[g & 7] = vsha512su1q_u64 (vsha512su0q_u64 (m[g & 7],
+							 m[(g + 1) & 7]),
+					m[(g + 7) & 7],
+					vextq_u64 (m[(g + 4) & 7],
+						   m[(g + 5) & 7], 1));
+
+	  s3 = vaddq_u64 (s3, vextq_u64 (wk, wk, 1));
+	  s3 = vsha512hq_u64 (s3, fg, de);
+	  s4 = vaddq_u64 (s1, s3);
+	  s3 = vsha512h2q_u64 (s3, s1, s0);
+
+	  /* S3 now holds the new AB and S4 the new EF.  */
+	  uint64x2_t t = s0;
+	  s0 = s3;
+	  s3 = s2;
+	  s2 = s4;
+	  s4 = s1;
+	  s1 = t;
+	}
+
+      /* Add the starting values of the context according to FIPS 180-2:6.2.2
+	 step 4.  */
+      ab = vaddq_u64 (s0, ab);
+      cd = vaddq_u64 (s1, cd);
+      ef = vaddq_u64 (s2, ef);
+      gh = vaddq_u64 (s3, gh);
+
+      /* Prepare for the next round.  */
+      words += 16;
+      nwords -= 16;
+    }
+
+  /* Put checksum in context given as argument.  */
+  vst1q_u64 (&ctx->H[0], ab);
+  vst1q_u64 (&ctx->H[2], cd);
+  vst1q_u64 (&ctx->H[4], ef);
+  vst1q_u64 (&ctx->H[6], gh);
+}
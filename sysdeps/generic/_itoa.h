@@ -55,6 +55,34 @@ hidden_proto (_itoa_lower_digits)
 extern char *_itoa_word (_ITOA_WORD_TYPE value, char *buflim,
 			 unsigned int base,
 			 int upper_case) attribute_hidden;
+
+extern const char _itoa_decimal_pairs[200] attribute_hidden;
+
+/* Convert VALUE into decimal ASCII, two digits at a time.  Write
+   backwards starting the character just before BUFLIM.  Return the
+   address of the first (left-to-right) character in the number.  */
+static inline char * __attribute__ ((unused, always_inline))
+_itoa_word_decimal (_ITOA_WORD_TYPE value, char *buflim)
+{
+  while (value >= 100)
+    {
+      const char *pair = &_itoa_decimal_pairs[2 * (value % 100)];
+      value /= 100;
+      buflim -= 2;
+      buflim[0] = pair[0];
+      buflim[1] = pair[1];
+    }
+  if (value >= 10)
+    {
+      const char *pair = &_itoa_decimal_pairs[2 * value];
+      buflim -= 2;
+      buflim[0] = pair[0];
+      buflim[1] = pair[1];
+    }
+  else
+    *--buflim = '0' + value;
+  return buflim;
+}
 #else
 static inline char * __attribute__ ((unused, always_inline))
 _itoa_word (_ITOA_WORD_TYPE value, char *buflim,
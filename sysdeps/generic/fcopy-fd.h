@@ -0,0 +1,40 @@
+/* Copy data between file descriptors for fcopy.  Generic version.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef FCOPY_FD_H
+#define FCOPY_FD_H
+
+#include <errno.h>
+#include <sys/types.h>
+
+/* Copy up to COUNT bytes from the current offset of INFD to the
+   current offset of OUTFD without passing them through user space.
+   *STATE is zero on the first call for a pair of descriptors and
+   records the method which works for them.  Return the number of
+   bytes copied, 0 at the end of file, or -1 with errno set.  ENOSYS
+   means that the data has to be copied through a buffer instead.
+
+   There is no such system call by default.  */
+static inline ssize_t
+__fcopy_fd (int infd, int outfd, size_t count, int *state)
+{
+  __set_errno (ENOSYS);
+  return -1;
+}
+
+#endif /* fcopy-fd.h */
@@ -378,6 +378,15 @@ struct rtld_global
 
   /* Incremented whenever something may have been added to dl_loaded.  */
   EXTERN unsigned long long _dl_load_adds;
+  /* Incremented whenever an object has been removed from dl_loaded.  */
+  EXTERN unsigned long long _dl_load_subs;
+
+  /* Number of objects at the start of the base namespace list which
+     have been loaded during startup.  These objects are never
+     unloaded, so this part of the list is not modified afterwards and
+     can be traversed without acquiring _dl_load_write_lock.  Zero
+     until startup has completed.  */
+  EXTERN unsigned int _dl_initial_nloaded;
 
   /* The object to be initialized first.  */
   EXTERN struct link_map *_dl_initfirst;
@@ -541,8 +550,9 @@ struct rtld_global_ro
 #define DL_DEBUG_STATISTICS (1 << 7)
 #define DL_DEBUG_UNUSED	    (1 << 8)
 #define DL_DEBUG_SCOPES	    (1 << 9)
+#define DL_DEBUG_PROFILE_STARTUP (1 << 10)
 /* These two are used only internally.  */
-#define DL_DEBUG_HELP       (1 << 10)
+#define DL_DEBUG_HELP       (1 << 11)
 
   /* Platform name.  */
   EXTERN const char *_dl_platform;
@@ -1249,9 +1259,11 @@ extern int _dl_scope_free (void *) attribute_hidden;
 extern void _dl_add_to_slotinfo (struct link_map *l, bool do_add)
   attribute_hidden;
 
-/* Update slot information data for at least the generation of the
-   module with the given index.  */
-extern struct link_map *_dl_update_slotinfo (unsigned long int req_modid)
+/* Update the DTV of the current thread to generation NEW_GEN, which
+   is at least the generation of the module with the given index.
+   Returns the link map of the module if its DTV entry was reset.  */
+extern struct link_map *_dl_update_slotinfo (unsigned long int req_modid,
+					     size_t new_gen)
      attribute_hidden;
 
 /* Look up the module's TLS block as for __tls_get_addr,
@@ -23,6 +23,9 @@ struct tls_internal_t
 {
   char *strsignal_buf;
   char *strerror_l_buf;
+  struct arc4random_state_t *rand_state;
+  struct printf_spec_cache *printf_spec_cache;
+  struct _IO_thread_buffer *stdio_thread_buffers;
 };
 
 #endif
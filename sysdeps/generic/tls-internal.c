@@ -16,6 +16,8 @@
    License along with the GNU C Library; if not, see
    <https://www.gnu.org/licenses/>.  */
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <tls-internal.h>
 
@@ -26,4 +28,10 @@ __glibc_tls_internal_free (void)
 {
   free (__tls_internal.strsignal_buf);
   free (__tls_internal.strerror_l_buf);
+  call_function_static_weak (__arc4random_state_free,
+			     __tls_internal.rand_state);
+  call_function_static_weak (__printf_spec_cache_free,
+			     __tls_internal.printf_spec_cache);
+  call_function_static_weak (_IO_thread_buffers_free,
+			     __tls_internal.stdio_thread_buffers);
 }
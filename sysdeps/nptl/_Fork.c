@@ -18,6 +18,7 @@
 
 #include <arch-fork.h>
 #include <pthreadP.h>
+#include <stdlib.h>
 
 pid_t
 _Fork (void)
@@ -43,6 +44,10 @@ _Fork (void)
       self->robust_head.list = &self->robust_head;
       INTERNAL_SYSCALL_CALL (set_robust_list, &self->robust_head,
 			     sizeof (struct robust_list_head));
+
+      /* The child must not produce the same arc4random output as the
+	 parent.  */
+      call_function_static_weak (__arc4random_fork_subprocess);
     }
   return pid;
 }
@@ -0,0 +1,81 @@
+/* Enumerate available IFUNC implementations of a function.  RISC-V version.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <string.h>
+#include <ifunc-impl-list.h>
+#include <init-arch.h>
+
+size_t
+__libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
+			size_t max)
+{
+  size_t i = max;
+
+  INIT_ARCH ();
+
+  /* Support sysdeps/riscv/multiarch/memchr.c.  */
+  IFUNC_IMPL (i, name, memchr,
+#if HAVE_RISCV_VECTOR_ASM
+	      IFUNC_IMPL_ADD (array, i, memchr, rvv, __memchr_rvv)
+#endif
+	      IFUNC_IMPL_ADD (array, i, memchr, 1, __memchr_generic))
+
+  /* Support sysdeps/riscv/multiarch/memcpy.c.  */
+  IFUNC_IMPL (i, name, memcpy,
+#if HAVE_RISCV_VECTOR_ASM
+	      IFUNC_IMPL_ADD (array, i, memcpy, rvv, __memcpy_rvv)
+#endif
+	      IFUNC_IMPL_ADD (array, i, memcpy, 1, __memcpy_generic))
+
+  /* Support sysdeps/riscv/multiarch/memmove.c.  */
+  IFUNC_IMPL (i, name, memmove,
+#if HAVE_RISCV_VECTOR_ASM
+	      IFUNC_IMPL_ADD (array, i, memmove, rvv, __memmove_rvv)
+#endif
+	      IFUNC_IMPL_ADD (array, i, memmove, 1, __memmove_generic))
+
+  /* Support sysdeps/riscv/multiarch/memset.c.  */
+  IFUNC_IMPL (i, name, memset,
+#if HAVE_RISCV_VECTOR_ASM
+	      IFUNC_IMPL_ADD (array, i, memset, rvv, __memset_rvv)
+#endif
+	      IFUNC_IMPL_ADD (array, i, memset, 1, __memset_generic))
+
+  /* Support sysdeps/riscv/multiarch/strchr.c.  */
+  IFUNC_IMPL (i, name, strchr,
+#if HAVE_RISCV_VECTOR_ASM
+	      IFUNC_IMPL_ADD (array, i, strchr, rvv, __strchr_rvv)
+#endif
+	      IFUNC_IMPL_ADD (array, i, strchr, 1, __strchr_generic))
+
+  /* Support sysdeps/riscv/multiarch/strcmp.c.  */
+  IFUNC_IMPL (i, name, strcmp,
+#if HAVE_RISCV_VECTOR_ASM
+	      IFUNC_IMPL_ADD (array, i, strcmp, rvv, __strcmp_rvv)
+#endif
+	      IFUNC_IMPL_ADD (array, i, strcmp, 1, __strcmp_generic))
+
+  /* Support sysdeps/riscv/multiarch/strlen.c.  */
+  IFUNC_IMPL (i, name, strlen,
+#if HAVE_RISCV_VECTOR_ASM
+	      IFUNC_IMPL_ADD (array, i, strlen, rvv, __strlen_rvv)
+#endif
+	      IFUNC_IMPL_ADD (array, i, strlen, 1, __strlen_generic))
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+/* Define INIT_ARCH for the RISC-V IFUNC selectors.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <ldsodefs.h>
+#include <ifunc-init.h>
+
+/* The kernel reports the single-letter base ISA extensions in
+   AT_HWCAP, one bit per letter.  */
+#define RISCV_HWCAP_ISA_V (1UL << ('V' - 'A'))
+
+#define INIT_ARCH()							      \
+  bool __attribute__((unused)) rvv =					      \
+    HAVE_RISCV_VECTOR_ASM && (GLRO(dl_hwcap) & RISCV_HWCAP_ISA_V);
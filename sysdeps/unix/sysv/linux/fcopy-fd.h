@@ -0,0 +1,94 @@
+/* Copy data between file descriptors for fcopy.  Linux version.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef FCOPY_FD_H
+#define FCOPY_FD_H
+
+#include <errno.h>
+#include <stdbool.h>
+#include <sys/sendfile.h>
+#include <sysdep-cancel.h>
+
+/* The methods, in the order in which they are tried.  copy_file_range
+   works between regular files, sendfile from a regular file to any
+   descriptor, and splice if either descriptor is a pipe.  */
+enum
+  {
+    FCOPY_FD_COPY_FILE_RANGE,
+    FCOPY_FD_SENDFILE,
+    FCOPY_FD_SPLICE,
+    FCOPY_FD_NONE
+  };
+
+/* The errors with which the system calls reject a pair of descriptors
+   before copying anything.  EBADF is the result of copy_file_range
+   for an output file opened with O_APPEND.  */
+static inline bool
+__fcopy_fd_unsupported (int error)
+{
+  return (error == ENOSYS || error == EXDEV || error == EINVAL
+	  || error == EOPNOTSUPP || error == EBADF);
+}
+
+/* Copy up to COUNT bytes from the current offset of INFD to the
+   current offset of OUTFD without passing them through user space.
+   *STATE is zero on the first call for a pair of descriptors and
+   records the method which works for them.  Return the number of
+   bytes copied, 0 at the end of file, or -1 with errno set.  ENOSYS
+   means that the data has to be copied through a buffer instead.  */
+static inline ssize_t
+__fcopy_fd (int infd, int outfd, size_t count, int *state)
+{
+  /* The kernel copies at most this much per call anyway.  */
+  if (count > 0x7ffff000)
+    count = 0x7ffff000;
+
+  while (true)
+    {
+      ssize_t ret;
+      switch (*state)
+	{
+	case FCOPY_FD_COPY_FILE_RANGE:
+	  ret = SYSCALL_CANCEL (copy_file_range, infd, NULL, outfd, NULL,
+				count, 0);
+	  /* Some pseudo-file systems report an empty file to
+	     copy_file_range, so let sendfile confirm the end of
+	     file.  */
+	  if (ret == 0)
+	    {
+	      *state = FCOPY_FD_SENDFILE;
+	      continue;
+	    }
+	  break;
+	case FCOPY_FD_SENDFILE:
+	  ret = __sendfile64 (outfd, infd, NULL, count);
+	  break;
+	case FCOPY_FD_SPLICE:
+	  ret = SYSCALL_CANCEL (splice, infd, NULL, outfd, NULL, count, 0);
+	  break;
+	default:
+	  __set_errno (ENOSYS);
+	  return -1;
+	}
+      if (ret >= 0 || !__fcopy_fd_unsupported (errno))
+	return ret;
+      ++*state;
+    }
+}
+
+#endif /* fcopy-fd.h */
@@ -20,9 +20,6 @@
 #include <sysdep.h>
 #include <shlib-compat.h>
 
-int __posix_fadvise64_l64 (int fd, off64_t offset, off64_t len, int advise);
-libc_hidden_proto (__posix_fadvise64_l64)
-
 /* Both arm and powerpc implements fadvise64_64 with last 'advise' argument
    just after 'fd' to avoid the requirement of implementing 7-arg syscalls.
    ARM also defines __NR_fadvise64_64 as __NR_arm_fadvise64_64.
@@ -19,7 +19,6 @@
 #include <fcntl.h>
 #include <sysdep.h>
 
-int __posix_fadvise64_l64 (int fd, off64_t offset, off64_t len, int advise);
 int __posix_fadvise64_l32 (int fd, off64_t offset, size_t len, int advise);
 
 /* Advice the system about the expected behaviour of the application with
@@ -64,3 +63,4 @@ compat_symbol (libc, __posix_fadvise64_l32, posix_fadvise64, GLIBC_2_2);
 #else
 strong_alias (__posix_fadvise64_l64, posix_fadvise64);
 #endif
+libc_hidden_def (__posix_fadvise64_l64)
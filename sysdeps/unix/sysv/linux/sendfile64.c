@@ -24,7 +24,7 @@
 /* Send COUNT bytes from file associated with IN_FD starting at OFFSET to
    descriptor OUT_FD.  */
 ssize_t
-sendfile64 (int out_fd, int in_fd, off64_t *offset, size_t count)
+__sendfile64 (int out_fd, int in_fd, off64_t *offset, size_t count)
 {
 #ifndef __NR_sendfile64
 # define __NR_sendfile64 __NR_sendfile
@@ -32,6 +32,7 @@ sendfile64 (int out_fd, int in_fd, off64_t *offset, size_t count)
   return INLINE_SYSCALL_CALL (sendfile64, out_fd, in_fd, offset, count);
 }
 
+weak_alias (__sendfile64, sendfile64)
 #ifdef __OFF_T_MATCHES_OFF64_T
-strong_alias (sendfile64, sendfile)
+strong_alias (__sendfile64, sendfile)
 #endif
@@ -16,6 +16,8 @@
    License along with the GNU C Library; if not, see
    <https://www.gnu.org/licenses/>.  */
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <tls-internal.h>
 
@@ -25,4 +27,10 @@ __glibc_tls_internal_free (void)
   struct pthread *self = THREAD_SELF;
   free (self->tls_state.strsignal_buf);
   free (self->tls_state.strerror_l_buf);
+  call_function_static_weak (__arc4random_state_free,
+			     self->tls_state.rand_state);
+  call_function_static_weak (__printf_spec_cache_free,
+			     self->tls_state.printf_spec_cache);
+  call_function_static_weak (_IO_thread_buffers_free,
+			     self->tls_state.stdio_thread_buffers);
 }
@@ -28,8 +28,13 @@
 #include <dl-tlsdesc.h>
 #include <dl-static-tls.h>
 #include <dl-machine-rel.h>
+#include <dl-irel.h>
+#include <dl-ifunc-cache.h>
 #include <isa-level.h>
 
+/* The relocation code below uses elf_ifunc_invoke_cached.  */
+#define ELF_MACHINE_IFUNC_CACHE 1
+
 /* Return nonzero iff ELF header is compatible with the running host.  */
 static inline int __attribute__ ((unused))
 elf_machine_matches_host (const ElfW(Ehdr) *ehdr)
@@ -297,7 +302,7 @@ and creates an unsatisfiable circular dependency.\n",
 				  strtab + refsym->st_name);
 	    }
 # endif
-	  value = ((ElfW(Addr) (*) (void)) value) ();
+	  value = elf_ifunc_invoke_cached (sym_map, value);
 	}
 
       switch (r_type)
@@ -459,7 +464,7 @@ and creates an unsatisfiable circular dependency.\n",
 	case R_X86_64_IRELATIVE:
 	  value = map->l_addr + reloc->r_addend;
 	  if (__glibc_likely (!skip_ifunc))
-	    value = ((ElfW(Addr) (*) (void)) value) ();
+	    value = elf_ifunc_invoke_cached (map, value);
 	  *reloc_addr = value;
 	  break;
 	default:
@@ -531,7 +536,7 @@ elf_machine_lazy_rel (struct link_map *map, struct r_scope_elem *scope[],
     {
       ElfW(Addr) value = map->l_addr + reloc->r_addend;
       if (__glibc_likely (!skip_ifunc))
-	value = ((ElfW(Addr) (*) (void)) value) ();
+	value = elf_ifunc_invoke_cached (map, value);
       *reloc_addr = value;
     }
   else
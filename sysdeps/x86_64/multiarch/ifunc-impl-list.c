@@ -116,6 +116,16 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
 				     1,
 				     __memcmp_sse2))
 
+  /* Support sysdeps/x86_64/multiarch/memmem.c.  */
+  IFUNC_IMPL (i, name, memmem,
+	      IFUNC_IMPL_ADD (array, i, memmem,
+			      (CPU_FEATURE_USABLE (AVX512F)
+			       && CPU_FEATURE_USABLE (AVX512BW)),
+			      __memmem_evex512)
+	      IFUNC_IMPL_ADD (array, i, memmem, CPU_FEATURE_USABLE (AVX2),
+			      __memmem_avx2)
+	      IFUNC_IMPL_ADD (array, i, memmem, 1, __memmem_generic))
+
 #ifdef SHARED
   /* Support sysdeps/x86_64/multiarch/memmove_chk.c.  */
   IFUNC_IMPL (i, name, __memmove_chk,
@@ -677,6 +687,12 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
   IFUNC_IMPL (i, name, strcspn,
 	      /* All implementations of strcspn are built at all ISA
 	         levels.  */
+	      IFUNC_IMPL_ADD (array, i, strcspn,
+			      (CPU_FEATURE_USABLE (AVX512F)
+			       && CPU_FEATURE_USABLE (AVX512BW)),
+			      __strcspn_evex512)
+	      IFUNC_IMPL_ADD (array, i, strcspn, CPU_FEATURE_USABLE (AVX2),
+			      __strcspn_avx2)
 	      IFUNC_IMPL_ADD (array, i, strcspn, CPU_FEATURE_USABLE (SSE4_2),
 			      __strcspn_sse42)
 	      IFUNC_IMPL_ADD (array, i, strcspn, 1, __strcspn_generic))
@@ -775,6 +791,12 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
   IFUNC_IMPL (i, name, strpbrk,
 	      /* All implementations of strpbrk are built at all ISA
 	         levels.  */
+	      IFUNC_IMPL_ADD (array, i, strpbrk,
+			      (CPU_FEATURE_USABLE (AVX512F)
+			       && CPU_FEATURE_USABLE (AVX512BW)),
+			      __strpbrk_evex512)
+	      IFUNC_IMPL_ADD (array, i, strpbrk, CPU_FEATURE_USABLE (AVX2),
+			      __strpbrk_avx2)
 	      IFUNC_IMPL_ADD (array, i, strpbrk, CPU_FEATURE_USABLE (SSE4_2),
 			      __strpbrk_sse42)
 	      IFUNC_IMPL_ADD (array, i, strpbrk, 1, __strpbrk_generic))
@@ -784,6 +806,12 @@ __libc_ifunc_impl_list (const char *name, struct libc_ifunc_impl *array,
   IFUNC_IMPL (i, name, strspn,
 	      /* All implementations of strspn are built at all ISA
 	         levels.  */
+	      IFUNC_IMPL_ADD (array, i, strspn,
+			      (CPU_FEATURE_USABLE (AVX512F)
+			       && CPU_FEATURE_USABLE (AVX512BW)),
+			      __strspn_evex512)
+	      IFUNC_IMPL_ADD (array, i, strspn, CPU_FEATURE_USABLE (AVX2),
+			      __strspn_avx2)
 	      IFUNC_IMPL_ADD (array, i, strspn, CPU_FEATURE_USABLE (SSE4_2),
 			      __strspn_sse42)
 	      IFUNC_IMPL_ADD (array, i, strspn, 1, __strspn_generic))
@@ -1,6 +1,6 @@
-/* Common definition for ifunc selections optimized with SSE2 and SSE4.2.
+/* Common definition for memmem ifunc selections.
    All versions must be listed in ifunc-impl-list.c.
-   Copyright (C) 2017-2023 Free Software Foundation, Inc.
+   Copyright (C) 2023 Free Software Foundation, Inc.
    This file is part of the GNU C Library.
 
    The GNU C Library is free software; you can redistribute it and/or
@@ -20,21 +20,27 @@
 #include <init-arch.h>
 
 extern __typeof (REDIRECT_NAME) OPTIMIZE (generic) attribute_hidden;
-extern __typeof (REDIRECT_NAME) OPTIMIZE (sse42) attribute_hidden;
+extern __typeof (REDIRECT_NAME) OPTIMIZE (avx2) attribute_hidden;
+extern __typeof (REDIRECT_NAME) OPTIMIZE (evex512) attribute_hidden;
 
 static inline void *
 IFUNC_SELECTOR (void)
 {
   const struct cpu_features* cpu_features = __get_cpu_features ();
 
-  /* This function uses the `pcmpstri` sse4.2 instruction which can be
-     slow on some CPUs.  This normally would be guarded by a
-     Slow_SSE4_2 check, but since there is no other optimized
-     implementation its best to keep it regardless.  If an optimized
-     fallback is added add a X86_ISA_CPU_FEATURE_ARCH_P (cpu_features,
-     Slow_SSE4_2) check.  */
-  if (X86_ISA_CPU_FEATURE_USABLE_P (cpu_features, SSE4_2))
-    return OPTIMIZE (sse42);
+  /* The vector versions are written in C and end with VZEROUPPER, which
+     aborts RTM transactions.  */
+  if (!CPU_FEATURE_USABLE_P (cpu_features, RTM))
+    {
+      if (X86_ISA_CPU_FEATURE_USABLE_P (cpu_features, AVX512BW)
+	  && !CPU_FEATURES_ARCH_P (cpu_features, Prefer_No_AVX512))
+	return OPTIMIZE (evex512);
+
+      if (X86_ISA_CPU_FEATURE_USABLE_P (cpu_features, AVX2)
+	  && X86_ISA_CPU_FEATURES_ARCH_P (cpu_features,
+					  Prefer_No_VZEROUPPER, !))
+	return OPTIMIZE (avx2);
+    }
 
   return OPTIMIZE (generic);
 }
@@ -0,0 +1,58 @@
+/* Common definition for strcspn, strpbrk and strspn ifunc selections.
+   All versions must be listed in ifunc-impl-list.c.
+   Copyright (C) 2017-2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <init-arch.h>
+
+extern __typeof (REDIRECT_NAME) OPTIMIZE (generic) attribute_hidden;
+extern __typeof (REDIRECT_NAME) OPTIMIZE (sse42) attribute_hidden;
+extern __typeof (REDIRECT_NAME) OPTIMIZE (avx2) attribute_hidden;
+extern __typeof (REDIRECT_NAME) OPTIMIZE (evex512) attribute_hidden;
+
+static inline void *
+IFUNC_SELECTOR (void)
+{
+  const struct cpu_features* cpu_features = __get_cpu_features ();
+
+  /* The AVX2 and EVEX512 versions are written in C, so they cannot
+     avoid VZEROUPPER the way the RTM variants of the assembler string
+     functions do.  Do not use them if RTM is usable, since VZEROUPPER
+     aborts transactions.  */
+  if (!CPU_FEATURE_USABLE_P (cpu_features, RTM))
+    {
+      if (X86_ISA_CPU_FEATURE_USABLE_P (cpu_features, AVX512BW)
+	  && !CPU_FEATURES_ARCH_P (cpu_features, Prefer_No_AVX512))
+	return OPTIMIZE (evex512);
+
+      if (X86_ISA_CPU_FEATURE_USABLE_P (cpu_features, AVX2)
+	  && X86_ISA_CPU_FEATURES_ARCH_P (cpu_features,
+					  Prefer_No_VZEROUPPER, !))
+	return OPTIMIZE (avx2);
+    }
+
+  /* This function uses the `pcmpstri` sse4.2 instruction which can be
+     slow on some CPUs.  This normally would be guarded by a
+     Slow_SSE4_2 check, but it is only reached when the AVX2 and
+     EVEX512 versions above cannot be used, and then the only other
+     choice is the generic version, so it is best to keep it
+     regardless.  */
+  if (X86_ISA_CPU_FEATURE_USABLE_P (cpu_features, SSE4_2))
+    return OPTIMIZE (sse42);
+
+  return OPTIMIZE (generic);
+}
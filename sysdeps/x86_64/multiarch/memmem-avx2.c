@@ -0,0 +1,116 @@
+/* memmem with 256-bit AVX2 instructions.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <immintrin.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* The haystack is processed 32 candidate positions at a time.  A
+   position is only verified with memcmp if both the first and the last
+   byte of the needle match, which rejects almost all positions for
+   typical data.  The loads never extend past the end of the haystack,
+   since the last byte of the needle is compared at the end of each
+   candidate.  Failed verifications are accounted for, and the search
+   switches to the generic implementation, which is linear in the worst
+   case, if they cost more than a few times the size of the haystack
+   scanned so far.  */
+
+#ifndef MEMMEM
+# define MEMMEM __memmem_avx2
+#endif
+
+#define VEC_SIZE 32
+
+extern __typeof (memmem) __memmem_generic attribute_hidden;
+
+/* Return the mask of the positions starting at P where both the first
+   and the last byte of the needle match.  */
+static inline uint32_t
+__attribute__ ((always_inline))
+candidates (const unsigned char *p, size_t m1, __m256i first, __m256i last)
+{
+  __m256i f = _mm256_cmpeq_epi8 (_mm256_loadu_si256 ((const __m256i *) p),
+				 first);
+  __m256i l = _mm256_cmpeq_epi8 (
+    _mm256_loadu_si256 ((const __m256i *) (p + m1)), last);
+  return _mm256_movemask_epi8 (_mm256_and_si256 (f, l));
+}
+
+void *
+__attribute__ ((section (".text.avx")))
+MEMMEM (const void *haystack, size_t hs_len,
+	const void *needle, size_t ne_len)
+{
+  const unsigned char *hs = (const unsigned char *) haystack;
+  const unsigned char *ne = (const unsigned char *) needle;
+
+  /* Needles of less than two bytes are handled with memchr, and a
+     haystack with less than a vector of candidate positions is not
+     worth the setup.  The Two-Way algorithm used by the generic code
+     for needles longer than 256 bytes skips large parts of the haystack
+     and is faster than scanning every position.  */
+  if (ne_len < 2 || ne_len > 256
+      || hs_len < ne_len || hs_len - ne_len < VEC_SIZE - 1)
+    return __memmem_generic (haystack, hs_len, needle, ne_len);
+
+  size_t m1 = ne_len - 1;
+  __m256i first = _mm256_set1_epi8 (ne[0]);
+  __m256i last = _mm256_set1_epi8 (ne[m1]);
+  /* The start of the last vector of candidate positions.  */
+  const unsigned char *last_vec = hs + hs_len - ne_len - (VEC_SIZE - 1);
+  const unsigned char *p = hs;
+  size_t cost = 0;
+
+  for (;;)
+    {
+      /* Skip quickly over pairs of vectors without candidates.  */
+      while (p + VEC_SIZE < last_vec
+	     && (candidates (p, m1, first, last)
+		 | candidates (p + VEC_SIZE, m1, first, last)) == 0)
+	p += 2 * VEC_SIZE;
+
+      /* The last vector overlaps the previous one, so skip the
+	 positions which have already been checked.  */
+      bool final = p >= last_vec;
+      unsigned int skip = 0;
+      if (final)
+	{
+	  skip = p - last_vec;
+	  p = last_vec;
+	}
+
+      uint32_t mask = candidates (p, m1, first, last) & (-1U << skip);
+      while (mask != 0)
+	{
+	  unsigned int i = __builtin_ctz (mask);
+	  if (memcmp (p + i + 1, ne + 1, m1 - 1) == 0)
+	    return (void *) (p + i);
+	  mask &= mask - 1;
+
+	  cost += ne_len;
+	  if (__glibc_unlikely (cost > 4 * (size_t) (p - hs) + 4096))
+	    return __memmem_generic (p + i + 1, hs + hs_len - (p + i + 1),
+				     needle, ne_len);
+	}
+
+      if (final)
+	return NULL;
+      p += VEC_SIZE;
+    }
+}
@@ -0,0 +1,106 @@
+/* memmem with 512-bit EVEX instructions.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <immintrin.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/* This is memmem-avx2.c processing 64 candidate positions at a time,
+   with the comparison results in mask registers.  */
+
+#ifndef MEMMEM
+# define MEMMEM __memmem_evex512
+#endif
+
+#define VEC_SIZE 64
+
+extern __typeof (memmem) __memmem_generic attribute_hidden;
+
+/* Return the mask of the positions starting at P where both the first
+   and the last byte of the needle match.  */
+static inline uint64_t
+__attribute__ ((always_inline))
+candidates (const unsigned char *p, size_t m1, __m512i first, __m512i last)
+{
+  __mmask64 f = _mm512_cmpeq_epi8_mask (_mm512_loadu_si512 (p), first);
+  return _mm512_mask_cmpeq_epi8_mask (f, _mm512_loadu_si512 (p + m1), last);
+}
+
+void *
+__attribute__ ((section (".text.evex512")))
+MEMMEM (const void *haystack, size_t hs_len,
+	const void *needle, size_t ne_len)
+{
+  const unsigned char *hs = (const unsigned char *) haystack;
+  const unsigned char *ne = (const unsigned char *) needle;
+
+  /* Needles of less than two bytes are handled with memchr, and a
+     haystack with less than a vector of candidate positions is not
+     worth the setup.  The Two-Way algorithm used by the generic code
+     for needles longer than 256 bytes skips large parts of the haystack
+     and is faster than scanning every position.  */
+  if (ne_len < 2 || ne_len > 256
+      || hs_len < ne_len || hs_len - ne_len < VEC_SIZE - 1)
+    return __memmem_generic (haystack, hs_len, needle, ne_len);
+
+  size_t m1 = ne_len - 1;
+  __m512i first = _mm512_set1_epi8 (ne[0]);
+  __m512i last = _mm512_set1_epi8 (ne[m1]);
+  /* The start of the last vector of candidate positions.  */
+  const unsigned char *last_vec = hs + hs_len - ne_len - (VEC_SIZE - 1);
+  const unsigned char *p = hs;
+  size_t cost = 0;
+
+  for (;;)
+    {
+      /* Skip quickly over pairs of vectors without candidates.  */
+      while (p + VEC_SIZE < last_vec
+	     && (candidates (p, m1, first, last)
+		 | candidates (p + VEC_SIZE, m1, first, last)) == 0)
+	p += 2 * VEC_SIZE;
+
+      /* The last vector overlaps the previous one, so skip the
+	 positions which have already been checked.  */
+      bool final = p >= last_vec;
+      unsigned int skip = 0;
+      if (final)
+	{
+	  skip = p - last_vec;
+	  p = last_vec;
+	}
+
+      uint64_t mask = candidates (p, m1, first, last) & (-1ULL << skip);
+      while (mask != 0)
+	{
+	  unsigned int i = __builtin_ctzll (mask);
+	  if (memcmp (p + i + 1, ne + 1, m1 - 1) == 0)
+	    return (void *) (p + i);
+	  mask &= mask - 1;
+
+	  cost += ne_len;
+	  if (__glibc_unlikely (cost > 4 * (size_t) (p - hs) + 4096))
+	    return __memmem_generic (p + i + 1, hs + hs_len - (p + i + 1),
+				     needle, ne_len);
+	}
+
+      if (final)
+	return NULL;
+      p += VEC_SIZE;
+    }
+}
@@ -0,0 +1,39 @@
+/* Multiple versions of memmem.
+   All versions must be listed in ifunc-impl-list.c.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+/* Define multiple versions only for the definition in libc.  */
+#if IS_IN (libc)
+# define memmem __redirect_memmem
+# define __memmem __redirect___memmem
+# include <string.h>
+# undef __memmem
+# undef memmem
+
+# define SYMBOL_NAME memmem
+# include "ifunc-memmem.h"
+
+libc_ifunc_redirected (__redirect_memmem, __memmem, IFUNC_SELECTOR ());
+weak_alias (__memmem, memmem)
+# ifdef SHARED
+__hidden_ver1 (__memmem, __GI___memmem, __redirect___memmem)
+  __attribute__ ((visibility ("hidden"))) __attribute_copy__ (memmem);
+__hidden_ver1 (__memmem, __GI_memmem, __redirect_memmem)
+  __attribute__ ((visibility ("hidden"))) __attribute_copy__ (memmem);
+# endif
+#endif
@@ -0,0 +1,124 @@
+/* SHA256 block function using the x86 SHA extensions.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <immintrin.h>
+#include <stdint.h>
+#include <crypt/sha256.h>
+
+/* Constants for SHA256 from FIPS 180-2:4.2.2.  */
+static const uint32_t K[64] __attribute__ ((aligned (16))) =
+  {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+/* Process LEN bytes of BUFFER, accumulating context into CTX.
+   It is assumed that LEN % 64 == 0.
+
+   SHA256RNDS2 operates on the state split into the two registers
+   ABEF and CDGH and performs two rounds at a time, so each group of
+   four message words takes two instructions.  SHA256MSG1 and
+   SHA256MSG2 compute the message schedule (FIPS 180-2:6.2.2 step 2)
+   four words at a time, twelve groups ahead of their use.  */
+void
+__sha256_process_block_shani (const void *buffer, size_t len,
+			      struct sha256_ctx *ctx)
+{
+  const __m128i *words = buffer;
+  size_t nblocks = len / 64;
+  const __m128i bswap_mask = _mm_set_epi64x (0x0c0d0e0f08090a0bULL,
+					     0x0405060700010203ULL);
+
+  /* First increment the byte count.  FIPS 180-2 specifies the possible
+     length of the file up to 2^64 bits.  Here we only compute the
+     number of bytes.  */
+  ctx->total64 += len;
+
+  /* Rearrange H[0..7] into ABEF and CDGH, with A and C in the most
+     significant lanes.  */
+  __m128i abcd = _mm_loadu_si128 ((const __m128i *) &ctx->H[0]);
+  __m128i efgh = _mm_loadu_si128 ((const __m128i *) &ctx->H[4]);
+  __m128i cdab = _mm_shuffle_epi32 (abcd, 0xb1);
+  efgh = _mm_shuffle_epi32 (efgh, 0x1b);
+  __m128i state0 = _mm_alignr_epi8 (cdab, efgh, 8);
+  __m128i state1 = _mm_blend_epi16 (efgh, cdab, 0xf0);
+
+  while (nblocks-- > 0)
+    {
+      __m128i state0_save = state0;
+      __m128i state1_save = state1;
+      __m128i m[4];
+
+      for (unsigned int g = 0; g < 16; ++g)
+	{
+	  if (g < 4)
+	    m[g] = _mm_shuffle_epi8 (_mm_loadu_si128 (&words[g]),
+				     bswap_mask);
+
+	  __m128i msg = _mm_add_epi32 (m[g & 3],
+				       _mm_load_si128 ((const __m128i *)
+						       &K[4 * g]));
+	  state1 = _mm_sha256rnds2_epu32 (state1, state0, msg);
+
+	  /* Group G + 1 needs the sum of the groups G - 3, G - 2 and
+	     G, with the last one only being available now.  */
+	  if (g >= 3 && g < 15)
+	    {
+	      __m128i *next = &m[(g + 1) & 3];
+	      __m128i w7 = _mm_alignr_epi8 (m[g & 3], m[(g - 1) & 3], 4);
+	      *next = _mm_sha256msg2_epu32 (_mm_add_epi32 (*next, w7),
+					    m[g & 3]);
+	    }
+
+	  msg = _mm_shuffle_epi32 (msg, 0x0e);
+	  state0 = _mm_sha256rnds2_epu32 (state0, state1, msg);
+
+	  if (g >= 1 && g < 13)
+	    m[(g - 1) & 3] = _mm_sha256msg1_epu32 (m[(g - 1) & 3], m[g & 3]);
+	}
+
+      /* Add the starting values of the context according to FIPS 180-2:6.2.2
+	 step 4.  */
+      state0 = _mm_add_epi32 (state0, state0_save);
+      state1 = _mm_add_epi32 (state1, state1_save);
+
+      words += 4;
+    }
+
+  /* Put checksum in context given as argument.  */
+  __m128i feba = _mm_shuffle_epi32 (state0, 0x1b);
+  __m128i dchg = _mm_shuffle_epi32 (state1, 0xb1);
+  abcd = _mm_blend_epi16 (feba, dchg, 0xf0);
+  efgh = _mm_alignr_epi8 (dchg, feba, 8);
+  _mm_storeu_si128 ((__m128i *) &ctx->H[0], abcd);
+  _mm_storeu_si128 ((__m128i *) &ctx->H[4], efgh);
+}
@@ -0,0 +1,108 @@
+/* strcspn with AVX2 intrinsics.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <immintrin.h>
+#include <string.h>
+#include "strcspn-table.h"
+
+/* The same code implements strcspn, strpbrk (USE_AS_STRPBRK) and
+   strspn (USE_AS_STRSPN).  The string is processed 32 bytes at a
+   time, using aligned loads so that no page boundary is crossed.  For
+   strcspn and strpbrk the NUL byte is added to the set, so the search
+   stops at the first byte in the set.  For strspn it stops at the first
+   byte not in the set, which is at the latest the NUL byte.  */
+
+#ifndef STRCSPN
+# ifdef USE_AS_STRPBRK
+#  define STRCSPN __strpbrk_avx2
+# elif defined USE_AS_STRSPN
+#  define STRCSPN __strspn_avx2
+# else
+#  define STRCSPN __strcspn_avx2
+# endif
+#endif
+
+#define VEC_SIZE 32
+
+/* Return a mask of the bytes of V which end the scan.  */
+static inline uint32_t
+__attribute__ ((always_inline))
+stop_mask (__m256i v, __m256i low, __m256i high, __m256i bits)
+{
+  __m256i row = _mm256_or_si256 (
+    _mm256_shuffle_epi8 (low, v),
+    _mm256_shuffle_epi8 (high,
+			 _mm256_xor_si256 (v, _mm256_set1_epi8 (0x80))));
+  __m256i nibble = _mm256_and_si256 (_mm256_srli_epi16 (v, 4),
+				     _mm256_set1_epi8 (0x0f));
+  __m256i bit = _mm256_shuffle_epi8 (bits, nibble);
+  uint32_t in_set = _mm256_movemask_epi8 (
+    _mm256_cmpeq_epi8 (_mm256_and_si256 (row, bit), bit));
+#ifdef USE_AS_STRSPN
+  return ~in_set;
+#else
+  return in_set;
+#endif
+}
+
+#ifdef USE_AS_STRPBRK
+char *
+#else
+size_t
+#endif
+__attribute__ ((section (".text.avx")))
+STRCSPN (const char *s, const char *set)
+{
+  struct strcspn_table table;
+#ifdef USE_AS_STRSPN
+  strcspn_table_init (&table, set, 0);
+#else
+  strcspn_table_init (&table, set, 1);
+#endif
+
+  __m256i low = _mm256_broadcastsi128_si256 (
+    _mm_loadu_si128 ((const __m128i *) table.low));
+  __m256i high = _mm256_broadcastsi128_si256 (
+    _mm_loadu_si128 ((const __m128i *) table.high));
+  __m256i bits = _mm256_broadcastsi128_si256 (
+    _mm_setr_epi8 (1, 2, 4, 8, 16, 32, 64, -128,
+		   1, 2, 4, 8, 16, 32, 64, -128));
+
+  unsigned int offset = (uintptr_t) s & (VEC_SIZE - 1);
+  const char *p = s - offset;
+  uint32_t mask = stop_mask (_mm256_load_si256 ((const __m256i *) p),
+			     low, high, bits) >> offset;
+  if (mask == 0)
+    {
+      do
+	{
+	  p += VEC_SIZE;
+	  mask = stop_mask (_mm256_load_si256 ((const __m256i *) p),
+			    low, high, bits);
+	}
+      while (mask == 0);
+      offset = 0;
+    }
+  const char *end = p + offset + __builtin_ctz (mask);
+
+#ifdef USE_AS_STRPBRK
+  return *end == '\0' ? NULL : (char *) end;
+#else
+  return end - s;
+#endif
+}
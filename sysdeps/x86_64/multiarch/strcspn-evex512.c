@@ -0,0 +1,101 @@
+/* strcspn with 512-bit EVEX intrinsics.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#include <immintrin.h>
+#include <string.h>
+#include "strcspn-table.h"
+
+/* This is strcspn-avx2.c processing 64 bytes at a time, with the
+   comparison results in mask registers.  */
+
+#ifndef STRCSPN
+# ifdef USE_AS_STRPBRK
+#  define STRCSPN __strpbrk_evex512
+# elif defined USE_AS_STRSPN
+#  define STRCSPN __strspn_evex512
+# else
+#  define STRCSPN __strcspn_evex512
+# endif
+#endif
+
+#define VEC_SIZE 64
+
+/* Return a mask of the bytes of V which end the scan.  */
+static inline uint64_t
+__attribute__ ((always_inline))
+stop_mask (__m512i v, __m512i low, __m512i high, __m512i bits)
+{
+  __m512i row = _mm512_or_si512 (
+    _mm512_shuffle_epi8 (low, v),
+    _mm512_shuffle_epi8 (high,
+			 _mm512_xor_si512 (v, _mm512_set1_epi8 (0x80))));
+  __m512i nibble = _mm512_and_si512 (_mm512_srli_epi16 (v, 4),
+				     _mm512_set1_epi8 (0x0f));
+  __m512i bit = _mm512_shuffle_epi8 (bits, nibble);
+#ifdef USE_AS_STRSPN
+  return _mm512_testn_epi8_mask (row, bit);
+#else
+  return _mm512_test_epi8_mask (row, bit);
+#endif
+}
+
+#ifdef USE_AS_STRPBRK
+char *
+#else
+size_t
+#endif
+__attribute__ ((section (".text.evex512")))
+STRCSPN (const char *s, const char *set)
+{
+  struct strcspn_table table;
+#ifdef USE_AS_STRSPN
+  strcspn_table_init (&table, set, 0);
+#else
+  strcspn_table_init (&table, set, 1);
+#endif
+
+  __m512i low = _mm512_broadcast_i32x4 (
+    _mm_loadu_si128 ((const __m128i *) table.low));
+  __m512i high = _mm512_broadcast_i32x4 (
+    _mm_loadu_si128 ((const __m128i *) table.high));
+  __m512i bits = _mm512_broadcast_i32x4 (
+    _mm_setr_epi8 (1, 2, 4, 8, 16, 32, 64, -128,
+		   1, 2, 4, 8, 16, 32, 64, -128));
+
+  unsigned int offset = (uintptr_t) s & (VEC_SIZE - 1);
+  const char *p = s - offset;
+  uint64_t mask = stop_mask (_mm512_load_si512 (p), low, high, bits)
+		  >> offset;
+  if (mask == 0)
+    {
+      do
+	{
+	  p += VEC_SIZE;
+	  mask = stop_mask (_mm512_load_si512 (p), low, high, bits);
+	}
+      while (mask == 0);
+      offset = 0;
+    }
+  const char *end = p + offset + __builtin_ctzll (mask);
+
+#ifdef USE_AS_STRPBRK
+  return *end == '\0' ? NULL : (char *) end;
+#else
+  return end - s;
+#endif
+}
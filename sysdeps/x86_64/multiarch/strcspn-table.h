@@ -0,0 +1,59 @@
+/* Byte set lookup tables for the vectorized strcspn, strpbrk and strspn.
+   Copyright (C) 2023 Free Software Foundation, Inc.
+   This file is part of the GNU C Library.
+
+   The GNU C Library is free software; you can redistribute it and/or
+   modify it under the terms of the GNU Lesser General Public
+   License as published by the Free Software Foundation; either
+   version 2.1 of the License, or (at your option) any later version.
+
+   The GNU C Library is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public
+   License along with the GNU C Library; if not, see
+   <https://www.gnu.org/licenses/>.  */
+
+#ifndef _STRCSPN_TABLE_H
+#define _STRCSPN_TABLE_H
+
+#include <stdint.h>
+
+/* The set of bytes is represented as a 256-bit bitmap split into two
+   16-byte tables indexed by the low nibble of the byte.  Bit N of
+   LOW[I] is set if byte N * 16 + I is in the set, and bit N of HIGH[I]
+   if byte 0x80 + N * 16 + I is.  Looking up a vector of bytes is then
+   two byte shuffles (which return zero for indexes with the top bit
+   set, so each table only matches its half of the byte values), and a
+   third shuffle selects the bit for the high nibble.  This handles
+   sets of any size in the same number of instructions.  */
+struct strcspn_table
+{
+  uint8_t low[16];
+  uint8_t high[16];
+};
+
+/* Fill TABLE with the bytes of the string SET, and with the NUL byte
+   if WITH_NUL.  */
+static inline void
+strcspn_table_init (struct strcspn_table *table, const char *set,
+		    int with_nul)
+{
+  for (int i = 0; i < 16; i++)
+    table->low[i] = table->high[i] = 0;
+  table->low[0] = with_nul ? 1 : 0;
+
+  for (const unsigned char *p = (const unsigned char *) set; *p != '\0';
+       p++)
+    {
+      unsigned int c = *p;
+      if (c < 0x80)
+	table->low[c & 15] |= 1 << (c >> 4);
+      else
+	table->high[c & 15] |= 1 << ((c >> 4) & 7);
+    }
+}
+
+#endif
@@ -24,7 +24,7 @@
 # undef strspn
 
 # define SYMBOL_NAME strspn
-# include "ifunc-sse4_2.h"
+# include "ifunc-strcspn.h"
 
 libc_ifunc_redirected (__redirect_strspn, strspn, IFUNC_SELECTOR ());
 